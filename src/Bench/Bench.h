@@ -0,0 +1,113 @@
+#pragma once
+#include <Core.h>
+#include <limits>
+
+namespace WavefrontPT::Integrator {
+	struct Scene;
+}
+
+namespace WavefrontPT::Bench {
+	// Inputs cycled through by every microbenchmark, small enough to stay in L1
+	constexpr uint32_t MICRO_INPUT_COUNT = 1024;
+	// Timed repetitions per microbenchmark, the fastest one is reported
+	constexpr int MICRO_REPETITIONS = 7;
+
+	struct MicroResult final {
+		std::string m_Name;
+		// What one operation is, e.g. "ray" or "8 lanes"
+		std::string m_Unit;
+		double m_NsPerOp = 0.0;
+		uint64_t m_OpsPerRepetition = 0;
+	};
+
+	struct MacroResult final {
+		std::string m_Scene;
+		std::string m_Mode;
+		unsigned int m_Threads = 0;
+		size_t m_Width = 0;
+		size_t m_Height = 0;
+		int m_SamplesPerPixel = 0;
+		// 0 for the run without Russian roulette
+		int m_RouletteDepth = 0;
+		double m_Seconds = 0.0;
+		double m_MraysPerSecond = 0.0;
+		double m_SamplesPerSecond = 0.0;
+		// Average segments per path
+		double m_PathLength = 0.0;
+		// Throughput relative to the single-thread run of the same scene, mode and roulette depth
+		double m_Speedup = 0.0;
+	};
+
+	struct MicroOptions final {
+		// Each repetition runs batches of MICRO_INPUT_COUNT ops until it lasts at least this long
+		double m_MinRepetitionMs = 20.0;
+	};
+
+	struct MacroOptions final {
+		size_t m_Width = 480;
+		size_t m_Height = 270;
+		int m_SamplesPerPixel = 8;
+		// Every scene and mode also runs with Russian roulette from this bounce on, 0 skips those runs
+		int m_RouletteDepth = 3;
+		// 0 runs 1, 2, 4, ... up to the hardware thread count
+		unsigned int m_MaxThreads = 0;
+		// Text scenes run in addition to the built-in ones
+		std::vector<std::string> m_ScenePaths;
+	};
+
+	// Keeps v_Value alive so the loop producing it is not optimized away
+	template<class T>
+	WF_FORCEINLINE void doNotOptimize(const T& ro_Value) {
+#if defined(_MSC_VER)
+		static volatile char sink;
+		sink = *reinterpret_cast<const volatile char*>(&ro_Value);
+#else
+		asm volatile("" : : "r,m"(ro_Value) : "memory");
+#endif
+	}
+
+	// Times v_Batch, which runs v_OpsPerBatch operations, best of MICRO_REPETITIONS
+	template<class Batch>
+	MicroResult measureMicro(const char* p_Name, const char* p_Unit, uint64_t v_OpsPerBatch,
+							 const MicroOptions& ro_Options, Batch&& u_Batch) {
+		using Clock = std::chrono::steady_clock;
+
+		// Calibrate the batch count on a warm cache
+		uint64_t batches = 1;
+		for (;;) {
+			const auto start = Clock::now();
+			for (uint64_t i = 0; i < batches; ++i)
+				u_Batch();
+			const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			if (ms >= ro_Options.m_MinRepetitionMs * 0.5) {
+				if (ms < ro_Options.m_MinRepetitionMs)
+					batches = uint64_t(double(batches) * ro_Options.m_MinRepetitionMs / std::max(ms, 1e-3)) + 1;
+				break;
+			}
+			batches *= 2;
+		}
+
+		double best = std::numeric_limits<double>::max();
+		for (int r = 0; r < MICRO_REPETITIONS; ++r) {
+			const auto start = Clock::now();
+			for (uint64_t i = 0; i < batches; ++i)
+				u_Batch();
+			best = std::min(best, std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+		}
+
+		MicroResult result;
+		result.m_Name = p_Name;
+		result.m_Unit = p_Unit;
+		result.m_OpsPerRepetition = batches * v_OpsPerBatch;
+		result.m_NsPerOp = best / double(result.m_OpsPerRepetition);
+		return result;
+	}
+
+	// Canned scene with many primitives: a grid of diffuse and metal spheres on a ground
+	// plane under four emitters. finalizeScene is left to the caller
+	void buildSphereGridScene(Integrator::Scene& ro_Scene);
+
+	void runMicroBenchmarks(const MicroOptions& ro_Options, std::vector<MicroResult>& ro_Results);
+	// Returns false if a scene could not be loaded or rendered
+	bool runMacroBenchmarks(const MacroOptions& ro_Options, std::vector<MacroResult>& ro_Results);
+}
@@ -0,0 +1,120 @@
+#include <Core.h>
+#include <Bench.h>
+
+#include <cstring>
+#include <iostream>
+
+using namespace WavefrontPT::Bench;
+
+static void printUsage() {
+	std::cout << "Usage: WavefrontPTBench [--micro 0|1] [--macro 0|1] [--out FILE] [--min-time-ms N]\n"
+		"                       [--width N] [--height N] [--spp N] [--rr-depth N] [--threads N] [--scene FILE]...\n";
+}
+
+// Names are plain identifiers and signatures, only quotes and backslashes need escaping
+static void writeString(std::ostream& ro_Out, const std::string& ro_Value) {
+	ro_Out << '"';
+	for (char c : ro_Value) {
+		if (c == '"' || c == '\\') ro_Out << '\\';
+		ro_Out << c;
+	}
+	ro_Out << '"';
+}
+
+// One object per line so two runs diff line by line
+static void writeJson(std::ostream& ro_Out, const std::vector<MicroResult>& ro_Micro, const std::vector<MacroResult>& ro_Macro) {
+	ro_Out.precision(6);
+	ro_Out << "{\n  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n";
+
+	ro_Out << "  \"micro\": [";
+	for (size_t i = 0; i < ro_Micro.size(); ++i) {
+		const MicroResult& r = ro_Micro[i];
+		ro_Out << (i ? ",\n    " : "\n    ") << "{\"name\": ";
+		writeString(ro_Out, r.m_Name);
+		ro_Out << ", \"unit\": ";
+		writeString(ro_Out, r.m_Unit);
+		ro_Out << ", \"nsPerOp\": " << r.m_NsPerOp << ", \"opsPerRepetition\": " << r.m_OpsPerRepetition << "}";
+	}
+	ro_Out << (ro_Micro.empty() ? "],\n" : "\n  ],\n");
+
+	ro_Out << "  \"macro\": [";
+	for (size_t i = 0; i < ro_Macro.size(); ++i) {
+		const MacroResult& r = ro_Macro[i];
+		ro_Out << (i ? ",\n    " : "\n    ") << "{\"scene\": ";
+		writeString(ro_Out, r.m_Scene);
+		ro_Out << ", \"mode\": ";
+		writeString(ro_Out, r.m_Mode);
+		ro_Out << ", \"threads\": " << r.m_Threads << ", \"width\": " << r.m_Width << ", \"height\": " << r.m_Height
+			<< ", \"spp\": " << r.m_SamplesPerPixel << ", \"rouletteDepth\": " << r.m_RouletteDepth
+			<< ", \"seconds\": " << r.m_Seconds
+			<< ", \"mraysPerSecond\": " << r.m_MraysPerSecond << ", \"samplesPerSecond\": " << r.m_SamplesPerSecond
+			<< ", \"pathLength\": " << r.m_PathLength << ", \"speedup\": " << r.m_Speedup << "}";
+	}
+	ro_Out << (ro_Macro.empty() ? "]\n" : "\n  ]\n") << "}\n";
+}
+
+int main(int argc, char** argv) {
+	bool micro = true;
+	bool macro = true;
+	std::string outPath;
+	MicroOptions microOptions;
+	MacroOptions macroOptions;
+
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (!value) {
+			printUsage();
+			return 1;
+		}
+
+		if (!std::strcmp(arg, "--micro")) micro = std::atoi(value) != 0;
+		else if (!std::strcmp(arg, "--macro")) macro = std::atoi(value) != 0;
+		else if (!std::strcmp(arg, "--out")) outPath = value;
+		else if (!std::strcmp(arg, "--min-time-ms")) microOptions.m_MinRepetitionMs = std::atof(value);
+		else if (!std::strcmp(arg, "--width")) macroOptions.m_Width = size_t(std::atoi(value));
+		else if (!std::strcmp(arg, "--height")) macroOptions.m_Height = size_t(std::atoi(value));
+		else if (!std::strcmp(arg, "--spp")) macroOptions.m_SamplesPerPixel = std::atoi(value);
+		else if (!std::strcmp(arg, "--rr-depth")) macroOptions.m_RouletteDepth = std::atoi(value);
+		else if (!std::strcmp(arg, "--threads")) macroOptions.m_MaxThreads = unsigned(std::max(0, std::atoi(value)));
+		else if (!std::strcmp(arg, "--scene")) macroOptions.m_ScenePaths.push_back(value);
+		else {
+			printUsage();
+			return 1;
+		}
+		++i;
+	}
+
+	if (!macroOptions.m_Width || !macroOptions.m_Height || macroOptions.m_SamplesPerPixel <= 0
+		|| macroOptions.m_RouletteDepth < 0 || microOptions.m_MinRepetitionMs <= 0.0) {
+		printUsage();
+		return 1;
+	}
+
+	std::vector<MicroResult> microResults;
+	if (micro) {
+		std::cerr << "Microbenchmarks\n";
+		runMicroBenchmarks(microOptions, microResults);
+		for (const MicroResult& r : microResults)
+			std::cerr << "  " << r.m_Name << ": " << r.m_NsPerOp << " ns per " << r.m_Unit << "\n";
+	}
+
+	std::vector<MacroResult> macroResults;
+	if (macro) {
+		std::cerr << "Macro benchmarks, " << macroOptions.m_Width << "x" << macroOptions.m_Height << " at "
+			<< macroOptions.m_SamplesPerPixel << " spp\n";
+		if (!runMacroBenchmarks(macroOptions, macroResults)) return 1;
+	}
+
+	if (outPath.empty()) {
+		writeJson(std::cout, microResults, macroResults);
+		return 0;
+	}
+	std::ofstream out(outPath);
+	if (!out) {
+		std::cerr << "Could not open " << outPath << "\n";
+		return 1;
+	}
+	writeJson(out, microResults, macroResults);
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include <Core.h>
+#include <Bench.h>
+
+#include <iostream>
+
+#include "Integrators.h"
+#include "Scene.h"
+#include "SceneLoader.h"
+
+namespace WavefrontPT::Bench {
+	using namespace WavefrontPT::Math;
+	using Integrator::IntegratorMode;
+
+	constexpr int SPHERE_GRID_SIZE = 24;
+
+	void buildSphereGridScene(Integrator::Scene& ro_Scene) {
+		using namespace Integrator;
+
+		ro_Scene.m_Camera.m_Origin = Point3(0.0f, 6.0f, 10.0f);
+		ro_Scene.m_Camera.m_LookAt = Point3(0.0f, 0.0f, -4.0f);
+		ro_Scene.m_Camera.m_VerticalFov = 60.0f;
+
+		const Integrator::Math::MaterialID lightMat = registerMaterial(ro_Scene,
+			Materials::Material(Vector3(1.0f), Vector3(12.0f, 11.0f, 9.0f), 0.0f, 0.0f));
+		const Integrator::Math::MaterialID groundMat = registerMaterial(ro_Scene,
+			Materials::Material(Vector3(0.7f), Vector3(0.0f), 0.0f, 1.0f));
+		const Integrator::Math::MaterialID sphereMats[] = {
+			registerMaterial(ro_Scene, Materials::Material(Vector3(0.8f, 0.3f, 0.2f), Vector3(0.0f), 0.0f, 1.0f)),
+			registerMaterial(ro_Scene, Materials::Material(Vector3(0.2f, 0.6f, 0.8f), Vector3(0.0f), 0.0f, 1.0f)),
+			registerMaterial(ro_Scene, Materials::Material(Vector3(0.9f, 0.9f, 0.9f), Vector3(0.0f), 1.0f, 0.2f)),
+			registerMaterial(ro_Scene, Materials::Material(Vector3(0.9f, 0.7f, 0.3f), Vector3(0.0f), 1.0f, 0.5f)),
+		};
+
+		addPlane(ro_Scene, Geometry::GPlane(Point3(0.0f, 0.0f, -4.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f),
+											Vector3(0.0f, 0.0f, 1.0f), 30.0f, 30.0f, groundMat, ro_Scene.m_PlaneCount));
+
+		for (int z = 0; z < SPHERE_GRID_SIZE; ++z) {
+			for (int x = 0; x < SPHERE_GRID_SIZE; ++x) {
+				const Point3 center(FP32(x - SPHERE_GRID_SIZE / 2) * 0.9f, 0.35f, -FP32(z) * 0.9f + 4.0f);
+				addSphere(ro_Scene, Geometry::GSphere(center, 0.35f, sphereMats[(x * 7 + z * 3) % 4], ro_Scene.m_SphereCount));
+			}
+		}
+
+		for (int i = 0; i < 4; ++i)
+			addSphere(ro_Scene, Geometry::GSphere(Point3(FP32(i) * 6.0f - 9.0f, 6.0f, -6.0f), 0.8f, lightMat,
+												  ro_Scene.m_SphereCount));
+	}
+
+	struct BenchScene final {
+		std::string m_Name;
+		Integrator::Scene m_Scene;
+	};
+
+	// 1, 2, 4, ... below v_MaxThreads, then v_MaxThreads itself
+	static std::vector<unsigned int> threadCounts(unsigned int v_MaxThreads) {
+		std::vector<unsigned int> counts;
+		for (unsigned int t = 1; t < v_MaxThreads; t *= 2)
+			counts.push_back(t);
+		counts.push_back(v_MaxThreads);
+		return counts;
+	}
+
+	bool runMacroBenchmarks(const MacroOptions& ro_Options, std::vector<MacroResult>& ro_Results) {
+		std::vector<std::unique_ptr<BenchScene>> scenes;
+
+		scenes.push_back(std::make_unique<BenchScene>());
+		scenes.back()->m_Name = "demo";
+		Integrator::buildDemoScene(scenes.back()->m_Scene);
+
+		scenes.push_back(std::make_unique<BenchScene>());
+		scenes.back()->m_Name = "sphere-grid";
+		buildSphereGridScene(scenes.back()->m_Scene);
+
+		for (const std::string& path : ro_Options.m_ScenePaths) {
+			scenes.push_back(std::make_unique<BenchScene>());
+			scenes.back()->m_Name = path;
+			bool fromCache = false;
+			std::string error;
+			if (!Integrator::loadScene(path.c_str(), scenes.back()->m_Scene, fromCache, error)) {
+				std::cerr << "Scene: " << error << "\n";
+				return false;
+			}
+		}
+
+		const unsigned int maxThreads = ro_Options.m_MaxThreads ? ro_Options.m_MaxThreads
+			: std::max(1u, std::thread::hardware_concurrency());
+		const IntegratorMode modes[] = { IntegratorMode::Megakernel, IntegratorMode::Wavefront };
+		// Without roulette first, so both path lengths of a scene and mode sit next to each other
+		std::vector<int> rouletteDepths = { 0 };
+		if (ro_Options.m_RouletteDepth > 0) rouletteDepths.push_back(ro_Options.m_RouletteDepth);
+
+		for (const std::unique_ptr<BenchScene>& bench : scenes) {
+			Integrator::finalizeScene(bench->m_Scene);
+
+			for (IntegratorMode mode : modes) {
+				const char* modeName = mode == IntegratorMode::Megakernel ? "megakernel" : "wavefront";
+
+				Integrator::RenderSettings settings;
+				settings.m_Width = ro_Options.m_Width;
+				settings.m_Height = ro_Options.m_Height;
+				settings.m_Mode = mode;
+
+				// Untimed single sample to fault in the scene and warm the caches
+				Integrator::RenderMeasurement measurement;
+				settings.m_SamplesPerPixel = 1;
+				if (!Integrator::measureRender(mode, settings, bench->m_Scene, measurement)) return false;
+
+				settings.m_SamplesPerPixel = ro_Options.m_SamplesPerPixel;
+				for (int rouletteDepth : rouletteDepths) {
+					settings.m_RouletteDepth = rouletteDepth;
+					double singleThreadRate = 0.0;
+					for (unsigned int threads : threadCounts(maxThreads)) {
+						settings.m_Threads = threads;
+						if (!Integrator::measureRender(mode, settings, bench->m_Scene, measurement)) return false;
+
+						MacroResult result;
+						result.m_Scene = bench->m_Name;
+						result.m_Mode = modeName;
+						result.m_Threads = measurement.m_Threads;
+						result.m_Width = settings.m_Width;
+						result.m_Height = settings.m_Height;
+						result.m_SamplesPerPixel = settings.m_SamplesPerPixel;
+						result.m_RouletteDepth = rouletteDepth;
+						result.m_Seconds = measurement.m_Seconds;
+						result.m_MraysPerSecond = double(measurement.m_Rays) / measurement.m_Seconds * 1e-6;
+						result.m_SamplesPerSecond = double(measurement.m_Samples) / measurement.m_Seconds;
+						result.m_PathLength = measurement.m_PathLength;
+						if (threads == 1) singleThreadRate = result.m_MraysPerSecond;
+						result.m_Speedup = singleThreadRate > 0.0 ? result.m_MraysPerSecond / singleThreadRate : 0.0;
+						ro_Results.push_back(result);
+
+						std::cerr << "  " << result.m_Scene << " " << modeName << " rr " << rouletteDepth << " x" << threads << ": "
+							<< result.m_MraysPerSecond << " Mrays/s, " << result.m_SamplesPerSecond << " samples/s, "
+							<< result.m_PathLength << " segments per path\n";
+					}
+				}
+			}
+		}
+		return true;
+	}
+}
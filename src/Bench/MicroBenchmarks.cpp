@@ -0,0 +1,222 @@
+#include <Core.h>
+#include <Bench.h>
+
+#include "Intersection.h"
+#include "Integrators.h"
+#include "Matrix.h"
+#include "Random.h"
+#include "Scene.h"
+#include "Transcendentals.h"
+#include "TransformIntrin.h"
+
+namespace WavefrontPT::Bench {
+	using namespace WavefrontPT::Math;
+	using Integrator::Math::HitRecord;
+	using Integrator::Math::Ray;
+
+	// Deterministic input in [v_Min, v_Max), value v_Dimension of input v_Index
+	static FP32 input(uint32_t v_Index, uint32_t v_Dimension, FP32 v_Min, FP32 v_Max) {
+		return v_Min + (v_Max - v_Min) * Integrators::Ops::toUnitFloat(Integrators::Ops::hashRandom(v_Index, v_Dimension));
+	}
+
+	static Vector3 inputVector(uint32_t v_Index, uint32_t v_Dimension, FP32 v_Min, FP32 v_Max) {
+		return Vector3(input(v_Index, v_Dimension, v_Min, v_Max), input(v_Index, v_Dimension + 1, v_Min, v_Max),
+					   input(v_Index, v_Dimension + 2, v_Min, v_Max));
+	}
+
+	// Rays leaving the box [-1, 1]^3 around the origin towards a point near v_Target
+	static std::vector<Ray> makeRays(const Point3& ro_Target, FP32 v_Spread) {
+		std::vector<Ray> rays;
+		rays.reserve(MICRO_INPUT_COUNT);
+		for (uint32_t i = 0; i < MICRO_INPUT_COUNT; ++i) {
+			const Vector3 offset = inputVector(i, 0, -1.0f, 1.0f);
+			const Point3 origin(offset.X, offset.Y, offset.Z);
+			const Point3 target = ro_Target + inputVector(i, 3, -v_Spread, v_Spread);
+			rays.emplace_back(origin, normalize(target - origin));
+		}
+		return rays;
+	}
+
+	static std::vector<Stripe3> makeStripes(uint32_t v_Dimension) {
+		std::vector<Stripe3> stripes(MICRO_INPUT_COUNT / 8);
+		for (uint32_t i = 0; i < stripes.size(); ++i) {
+			alignas(32) FP32 lanes[3][8];
+			for (uint32_t lane = 0; lane < 8; ++lane)
+				for (uint32_t axis = 0; axis < 3; ++axis)
+					lanes[axis][lane] = input(i * 8 + lane, v_Dimension + axis, -4.0f, 4.0f);
+			stripes[i] = Stripe3(_mm256_load_ps(lanes[0]), _mm256_load_ps(lanes[1]), _mm256_load_ps(lanes[2]));
+		}
+		return stripes;
+	}
+
+	static Mat4f makeMatrix4(uint32_t v_Index) {
+		return translation(inputVector(v_Index, 0, -5.0f, 5.0f))
+			* rotate4(inputVector(v_Index, 3, -1.0f, 1.0f), input(v_Index, 6, 0.0f, 6.28f))
+			* scale4(inputVector(v_Index, 7, 0.5f, 2.0f));
+	}
+
+	static Mat3f makeMatrix3(uint32_t v_Index) {
+		return rotate3(inputVector(v_Index, 3, -1.0f, 1.0f), input(v_Index, 6, 0.0f, 6.28f))
+			* scale3(inputVector(v_Index, 7, 0.5f, 2.0f));
+	}
+
+	static void benchIntersection(const MicroOptions& ro_Options, std::vector<MicroResult>& ro_Results) {
+		// About half of the rays hit in both cases
+		const Geometry::GSphere sphere(Point3(0.0f, 0.0f, -5.0f), 1.0f, 0, 0);
+		const std::vector<Ray> sphereRays = makeRays(sphere.m_Center, 2.0f);
+		ro_Results.push_back(measureMicro("Geometry::hit(GSphere)", "ray", MICRO_INPUT_COUNT, ro_Options, [&]() {
+			for (const Ray& ray : sphereRays)
+				doNotOptimize(Geometry::hit(ray, sphere));
+		}));
+
+		const Geometry::GPlane plane(Point3(0.0f, -2.0f, -5.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f),
+									 Vector3(0.0f, 0.0f, 1.0f), 2.0f, 2.0f, 0, 0);
+		const std::vector<Ray> planeRays = makeRays(plane.m_Center, 3.0f);
+		ro_Results.push_back(measureMicro("Geometry::hit(GPlane)", "ray", MICRO_INPUT_COUNT, ro_Options, [&]() {
+			for (const Ray& ray : planeRays)
+				doNotOptimize(Geometry::hit(ray, plane));
+		}));
+	}
+
+	static void benchHitScene(const char* p_Name, const Integrator::Scene& ro_Scene, const MicroOptions& ro_Options,
+							  std::vector<MicroResult>& ro_Results) {
+		// Camera rays over the whole frame in a scrambled order
+		const Integrator::Camera camera = Integrator::makeCamera(ro_Scene.m_Camera, 16.0f / 9.0f);
+		std::vector<Ray> rays;
+		rays.reserve(MICRO_INPUT_COUNT);
+		for (uint32_t i = 0; i < MICRO_INPUT_COUNT; ++i)
+			rays.push_back(Integrator::generateCameraRay(camera, input(i, 0, 0.0f, 1.0f), input(i, 1, 0.0f, 1.0f)));
+
+		ro_Results.push_back(measureMicro(p_Name, "ray", MICRO_INPUT_COUNT, ro_Options, [&]() {
+			for (const Ray& ray : rays)
+				doNotOptimize(Integrator::hitScene(ro_Scene, ray));
+		}));
+	}
+
+	static void benchFunctions(const MicroOptions& ro_Options, std::vector<MicroResult>& ro_Results) {
+		std::vector<Vector3> vectors;
+		std::vector<FP32> values;
+		for (uint32_t i = 0; i < MICRO_INPUT_COUNT; ++i) {
+			vectors.push_back(inputVector(i, 0, -4.0f, 4.0f));
+			values.push_back(input(i, 3, 1e-3f, 1e3f));
+		}
+		const std::vector<Stripe3> stripes = makeStripes(4);
+
+		ro_Results.push_back(measureMicro("normalize(Vector3)", "vector", MICRO_INPUT_COUNT, ro_Options, [&]() {
+			for (const Vector3& v : vectors)
+				doNotOptimize(normalize(v));
+		}));
+		ro_Results.push_back(measureMicro("normalize(Stripe3)", "8 lanes", stripes.size(), ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(normalize(s));
+		}));
+		ro_Results.push_back(measureMicro("rSqrt(float)", "value", MICRO_INPUT_COUNT, ro_Options, [&]() {
+			for (FP32 v : values)
+				doNotOptimize(rSqrt(v));
+		}));
+		ro_Results.push_back(measureMicro("rSqrt(Reg8)", "8 lanes", MICRO_INPUT_COUNT / 8, ro_Options, [&]() {
+			for (uint32_t i = 0; i < MICRO_INPUT_COUNT; i += 8)
+				doNotOptimize(rSqrt(_mm256_loadu_ps(values.data() + i)));
+		}));
+
+		std::vector<FP32> angles;
+		for (uint32_t i = 0; i < MICRO_INPUT_COUNT; ++i)
+			angles.push_back(input(i, 7, 0.0f, 2.0f * std::numbers::pi_v<float>));
+
+		ro_Results.push_back(measureMicro("Transcendentals::sincos(float)", "value", MICRO_INPUT_COUNT, ro_Options, [&]() {
+			for (FP32 angle : angles)
+				doNotOptimize(Transcendentals::sincos(angle));
+		}));
+		ro_Results.push_back(measureMicro("Transcendentals::sincos(Reg8)", "8 lanes", MICRO_INPUT_COUNT / 8, ro_Options, [&]() {
+			for (uint32_t i = 0; i < MICRO_INPUT_COUNT; i += 8) {
+				Reg8 s, c;
+				Transcendentals::sincos(_mm256_loadu_ps(angles.data() + i), s, c);
+				doNotOptimize(s);
+				doNotOptimize(c);
+			}
+		}));
+	}
+
+	static void benchMatrix(const MicroOptions& ro_Options, std::vector<MicroResult>& ro_Results) {
+		// Fewer matrices than other inputs, they are 16 times the size
+		constexpr uint32_t MATRIX_COUNT = MICRO_INPUT_COUNT / 8;
+		std::vector<Mat4f> mats4;
+		std::vector<Mat3f> mats3;
+		for (uint32_t i = 0; i < MATRIX_COUNT; ++i) {
+			mats4.push_back(makeMatrix4(i));
+			mats3.push_back(makeMatrix3(i));
+		}
+
+		ro_Results.push_back(measureMicro("Mat3f * Mat3f", "matrix", MATRIX_COUNT - 1, ro_Options, [&]() {
+			for (uint32_t i = 0; i + 1 < MATRIX_COUNT; ++i)
+				doNotOptimize(mats3[i] * mats3[i + 1]);
+		}));
+		ro_Results.push_back(measureMicro("Mat4f * Mat4f", "matrix", MATRIX_COUNT - 1, ro_Options, [&]() {
+			for (uint32_t i = 0; i + 1 < MATRIX_COUNT; ++i)
+				doNotOptimize(mats4[i] * mats4[i + 1]);
+		}));
+		ro_Results.push_back(measureMicro("inverse(Mat3f)", "matrix", MATRIX_COUNT, ro_Options, [&]() {
+			for (const Mat3f& m : mats3)
+				doNotOptimize(inverse(m));
+		}));
+		ro_Results.push_back(measureMicro("inverse(Mat4f)", "matrix", MATRIX_COUNT, ro_Options, [&]() {
+			for (const Mat4f& m : mats4)
+				doNotOptimize(inverse(m));
+		}));
+	}
+
+	static void benchTransforms(const MicroOptions& ro_Options, std::vector<MicroResult>& ro_Results) {
+		const Mat4f mat4 = makeMatrix4(0);
+		const Mat3f mat3 = makeMatrix3(0);
+		const Transform transform = makeTransform(mat4);
+		const std::vector<Stripe3> stripes = makeStripes(0);
+		const uint64_t ops = stripes.size();
+
+		ro_Results.push_back(measureMicro("transformPoint(Mat4f, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(transformPoint(mat4, s));
+		}));
+		ro_Results.push_back(measureMicro("transformVector(Mat4f, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(transformVector(mat4, s));
+		}));
+		ro_Results.push_back(measureMicro("transformNormal(Mat4f, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(transformNormal(mat4, s));
+		}));
+		ro_Results.push_back(measureMicro("transformVector(Mat3f, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(transformVector(mat3, s));
+		}));
+		ro_Results.push_back(measureMicro("transformNormal(Mat3f, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(transformNormal(mat3, s));
+		}));
+		ro_Results.push_back(measureMicro("applyPoint(Transform, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(applyPoint(transform, s));
+		}));
+		ro_Results.push_back(measureMicro("applyNormal(Transform, Stripe3)", "8 lanes", ops, ro_Options, [&]() {
+			for (const Stripe3& s : stripes)
+				doNotOptimize(applyNormal(transform, s));
+		}));
+	}
+
+	void runMicroBenchmarks(const MicroOptions& ro_Options, std::vector<MicroResult>& ro_Results) {
+		benchIntersection(ro_Options, ro_Results);
+
+		Integrator::Scene demo;
+		Integrator::buildDemoScene(demo);
+		Integrator::finalizeScene(demo);
+		benchHitScene("hitScene(demo)", demo, ro_Options, ro_Results);
+
+		Integrator::Scene grid;
+		buildSphereGridScene(grid);
+		Integrator::finalizeScene(grid);
+		benchHitScene("hitScene(sphere-grid)", grid, ro_Options, ro_Results);
+
+		benchFunctions(ro_Options, ro_Results);
+		benchMatrix(ro_Options, ro_Results);
+		benchTransforms(ro_Options, ro_Results);
+	}
+}
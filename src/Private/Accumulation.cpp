@@ -0,0 +1,54 @@
+#include <Core.h>
+#include <Accumulation.h>
+
+#include "FileOutput.h"
+
+namespace WavefrontPT::Integrator {
+	void testConvergence(PixelStats& ro_Stats, Math::FP32 v_Threshold) {
+		if (v_Threshold <= 0.0f || ro_Stats.m_Samples < 2) return;
+
+		const Math::FP32 n = Math::FP32(ro_Stats.m_Samples);
+		const Math::FP32 variance = ro_Stats.m_M2 / (n - 1.0f);
+		const Math::FP32 standardError = std::sqrt(variance / n);
+		if (standardError <= v_Threshold * std::max(ro_Stats.m_Mean, ADAPTIVE_MEAN_FLOOR))
+			ro_Stats.m_Converged = 1;
+	}
+
+	bool AccumulationBuffer::initialize(size_t v_Width, size_t v_Height) {
+		m_Width = v_Width;
+		m_Height = v_Height;
+		const size_t count = pixelCount();
+
+		if (!m_SumArena.reserve(count * sizeof(Math::Vector3)) || !m_StatsArena.reserve(count * sizeof(PixelStats)))
+			return false;
+		m_SumArena.adviseHugePages();
+		m_StatsArena.adviseHugePages();
+
+		m_Sum = m_SumArena.commitForward(count);
+		m_Stats = m_StatsArena.commitForward(count);
+		return m_Sum && m_Stats;
+	}
+
+	void resolve(const AccumulationBuffer& ro_Buffer, Math::Vector3* p_Image) {
+		for (size_t i = 0; i < ro_Buffer.pixelCount(); ++i) {
+			const uint32_t samples = ro_Buffer.m_Stats[i].m_Samples;
+			p_Image[i] = samples ? Math::scale(ro_Buffer.m_Sum[i], 1.0f / Math::FP32(samples)) : Math::Vector3(0.0f);
+		}
+	}
+
+	void writeSampleHeatmap(const char* p_Filename, const AccumulationBuffer& ro_Buffer, Math::Vector3* p_Scratch) {
+		uint32_t fewest = UINT32_MAX, most = 0;
+		for (size_t i = 0; i < ro_Buffer.pixelCount(); ++i) {
+			fewest = std::min(fewest, ro_Buffer.m_Stats[i].m_Samples);
+			most = std::max(most, ro_Buffer.m_Stats[i].m_Samples);
+		}
+
+		const Math::FP32 range = most > fewest ? Math::FP32(most - fewest) : 1.0f;
+		for (size_t i = 0; i < ro_Buffer.pixelCount(); ++i) {
+			const Math::FP32 t = Math::FP32(ro_Buffer.m_Stats[i].m_Samples - fewest) / range;
+			p_Scratch[i] = Math::Vector3(t, 0.0f, 1.0f - t);
+		}
+
+		Output::writePPM(p_Filename, p_Scratch, ro_Buffer.m_Width, ro_Buffer.m_Height);
+	}
+}
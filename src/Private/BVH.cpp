@@ -0,0 +1,501 @@
+#include <Core.h>
+#include <BVH.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "Intersection.h"
+
+namespace WavefrontPT::Geometry {
+	using namespace Integrator::Math;
+
+	// Keeps planes aligned to an axis from collapsing into zero-width slabs
+	constexpr FP32 kBoundsPadding = 1e-4f;
+
+	AABB bounds(const GSphere& ro_Sphere) {
+		const Point3& c = ro_Sphere.m_Center;
+		const FP32 r = ro_Sphere.m_Radius;
+		return AABB(Point3(c.X - r, c.Y - r, c.Z - r), Point3(c.X + r, c.Y + r, c.Z + r));
+	}
+
+	AABB bounds(const GPlane& ro_Plane) {
+		const Vector3& t = ro_Plane.m_Tangent;
+		const Vector3& b = ro_Plane.m_BiTangent;
+		const FP32 hw = ro_Plane.m_HalfWidth, hb = ro_Plane.m_HalfBreadth;
+
+		Vector3 extent(
+			absFast(t.X) * hw + absFast(b.X) * hb + kBoundsPadding,
+			absFast(t.Y) * hw + absFast(b.Y) * hb + kBoundsPadding,
+			absFast(t.Z) * hw + absFast(b.Z) * hb + kBoundsPadding);
+
+		const Point3& c = ro_Plane.m_Center;
+		return AABB(Point3(c.X - extent.X, c.Y - extent.Y, c.Z - extent.Z),
+					Point3(c.X + extent.X, c.Y + extent.Y, c.Z + extent.Z));
+	}
+
+	// ----------------------------------------------------------------------------------
+	// Build
+	// ----------------------------------------------------------------------------------
+
+	// Nodes committed per arena growth step
+	constexpr size_t kNodeCommitChunk = 4096;
+
+	struct BuildPrimitive final {
+		AABB m_Bounds;
+		FP32 m_Centroid[3];
+		PrimitiveRef m_Ref;
+	};
+
+	struct BuildBin final {
+		AABB m_Bounds;
+		AABB m_CentroidBounds;
+		uint32_t m_Count = 0;
+	};
+
+	struct BinSet final {
+		BuildBin m_Bins[3][BVH_BIN_COUNT];
+
+		void merge(const BinSet& ro_Other) {
+			for (int a = 0; a < 3; ++a) {
+				for (uint32_t b = 0; b < BVH_BIN_COUNT; ++b) {
+					m_Bins[a][b].m_Bounds.grow(ro_Other.m_Bins[a][b].m_Bounds);
+					m_Bins[a][b].m_CentroidBounds.grow(ro_Other.m_Bins[a][b].m_CentroidBounds);
+					m_Bins[a][b].m_Count += ro_Other.m_Bins[a][b].m_Count;
+				}
+			}
+		}
+	};
+
+	struct BuildContext final {
+		std::vector<BuildPrimitive>& m_Prims;
+		BVH& m_BVH;
+		unsigned int m_ThreadCount;
+
+		std::atomic<uint32_t> m_NextNode{ 0 };
+		std::atomic<size_t> m_Committed{ 0 };
+		std::mutex m_CommitLock;
+		std::atomic<int> m_IdleWorkers{ 0 };
+
+		BuildContext(std::vector<BuildPrimitive>& ro_Prims, BVH& ro_BVH, unsigned int v_ThreadCount)
+			: m_Prims(ro_Prims), m_BVH(ro_BVH), m_ThreadCount(v_ThreadCount),
+			m_IdleWorkers(static_cast<int>(v_ThreadCount) - 1) {}
+	};
+
+	// Splits [v_Begin, v_End) into one chunk per worker, chunk 0 runs on the calling thread
+	template<typename Fn>
+	static void parallelChunks(unsigned int v_ThreadCount, uint32_t v_Begin, uint32_t v_End, Fn&& u_Fn) {
+		const uint32_t count = v_End - v_Begin;
+		const uint32_t chunks = std::max(1u, std::min<uint32_t>(v_ThreadCount, count));
+		const uint32_t chunkSize = (count + chunks - 1) / chunks;
+
+		std::vector<std::thread> workers;
+		workers.reserve(chunks - 1);
+		for (uint32_t c = 1; c < chunks; ++c) {
+			uint32_t b = v_Begin + c * chunkSize;
+			uint32_t e = std::min(v_End, b + chunkSize);
+			if (b >= e) break;
+			workers.emplace_back([&u_Fn, c, b, e]() { u_Fn(c, b, e); });
+		}
+		u_Fn(0u, v_Begin, std::min(v_End, v_Begin + chunkSize));
+		for (auto& w : workers) w.join();
+	}
+
+	static uint32_t allocateNodePair(BuildContext& ro_Ctx) {
+		const uint32_t index = ro_Ctx.m_NextNode.fetch_add(2, std::memory_order_relaxed);
+		const size_t needed = size_t(index) + 2;
+		if (ro_Ctx.m_Committed.load(std::memory_order_acquire) < needed) {
+			std::lock_guard<std::mutex> lock(ro_Ctx.m_CommitLock);
+			Memory::ArenaWalker<BVHNode>& arena = ro_Ctx.m_BVH.m_NodeArena;
+			while (arena.committedCount() < needed) {
+				const size_t remaining = arena.reservedCount() - arena.committedCount();
+				// The reservation covers the 2N - 1 worst case, running dry here is a builder bug
+				if (!arena.commitForward(std::min(kNodeCommitChunk, remaining))) std::abort();
+			}
+			ro_Ctx.m_Committed.store(arena.committedCount(), std::memory_order_release);
+		}
+		return index;
+	}
+
+	static uint32_t binIndex(FP32 v_Centroid, FP32 v_Min, FP32 v_Scale) {
+		int bin = static_cast<int>((v_Centroid - v_Min) * v_Scale);
+		return static_cast<uint32_t>(std::clamp(bin, 0, static_cast<int>(BVH_BIN_COUNT) - 1));
+	}
+
+	static void binRange(const BuildPrimitive* p_Prims, uint32_t v_Begin, uint32_t v_End,
+						 const AABB& ro_CentroidBounds, const FP32 (&ro_Scale)[3], BinSet& ro_Bins) {
+		for (uint32_t i = v_Begin; i < v_End; ++i) {
+			const BuildPrimitive& prim = p_Prims[i];
+			for (int a = 0; a < 3; ++a) {
+				BuildBin& bin = ro_Bins.m_Bins[a][binIndex(prim.m_Centroid[a], ro_CentroidBounds.m_Min[a], ro_Scale[a])];
+				bin.m_Bounds.grow(prim.m_Bounds);
+				bin.m_CentroidBounds.grow(prim.m_Centroid);
+				++bin.m_Count;
+			}
+		}
+	}
+
+	static void computeBounds(const BuildPrimitive* p_Prims, uint32_t v_Begin, uint32_t v_End,
+							  AABB& ro_Bounds, AABB& ro_CentroidBounds) {
+		for (uint32_t i = v_Begin; i < v_End; ++i) {
+			ro_Bounds.grow(p_Prims[i].m_Bounds);
+			ro_CentroidBounds.grow(p_Prims[i].m_Centroid);
+		}
+	}
+
+	static void buildNode(BuildContext& ro_Ctx, uint32_t v_Node, uint32_t v_Begin, uint32_t v_End, uint32_t v_Depth,
+						  const AABB& ro_Bounds, const AABB& ro_CentroidBounds) {
+		BVHNode& node = ro_Ctx.m_BVH.m_Nodes[v_Node];
+		const uint32_t count = v_End - v_Begin;
+		node.m_Bounds = ro_Bounds;
+		node.m_Offset = v_Begin;
+		node.m_Count = count;
+
+		if (count == 1 || v_Depth + 1 >= BVH_MAX_DEPTH) return;
+
+		BuildPrimitive* prims = ro_Ctx.m_Prims.data();
+
+		FP32 scale[3];
+		bool splittable = false;
+		for (int a = 0; a < 3; ++a) {
+			FP32 extent = ro_CentroidBounds.extent(a);
+			scale[a] = extent > 0.0f ? FP32(BVH_BIN_COUNT) / extent : 0.0f;
+			splittable |= extent > 0.0f;
+		}
+
+		uint32_t split = 0;
+		AABB leftBounds, rightBounds, leftCentroids, rightCentroids;
+
+		if (splittable) {
+			BinSet bins;
+			if (count >= BVH_PARALLEL_BIN_THRESHOLD && ro_Ctx.m_ThreadCount > 1) {
+				std::vector<BinSet> partial(ro_Ctx.m_ThreadCount);
+				parallelChunks(ro_Ctx.m_ThreadCount, v_Begin, v_End,
+							   [&](uint32_t v_Chunk, uint32_t v_B, uint32_t v_E) {
+								   binRange(prims, v_B, v_E, ro_CentroidBounds, scale, partial[v_Chunk]);
+							   });
+				for (const BinSet& p : partial) bins.merge(p);
+			} else {
+				binRange(prims, v_Begin, v_End, ro_CentroidBounds, scale, bins);
+			}
+
+			const FP32 parentArea = ro_Bounds.surfaceArea();
+			FP32 bestCost = INFINITY;
+			int bestAxis = -1;
+			uint32_t bestBin = 0;
+
+			for (int axis = 0; axis < 3; ++axis) {
+				if (scale[axis] == 0.0f) continue;
+				const BuildBin* axisBins = bins.m_Bins[axis];
+
+				FP32 rightArea[BVH_BIN_COUNT];
+				uint32_t rightCount[BVH_BIN_COUNT];
+				AABB right;
+				uint32_t rCount = 0;
+				for (uint32_t b = BVH_BIN_COUNT - 1; b > 0; --b) {
+					right.grow(axisBins[b].m_Bounds);
+					rCount += axisBins[b].m_Count;
+					rightArea[b] = right.surfaceArea();
+					rightCount[b] = rCount;
+				}
+
+				AABB left;
+				uint32_t lCount = 0;
+				for (uint32_t b = 1; b < BVH_BIN_COUNT; ++b) {
+					left.grow(axisBins[b - 1].m_Bounds);
+					lCount += axisBins[b - 1].m_Count;
+					if (!lCount || !rightCount[b]) continue;
+					FP32 cost = SAH_TRAVERSAL_COST + SAH_INTERSECTION_COST *
+						(left.surfaceArea() * FP32(lCount) + rightArea[b] * FP32(rightCount[b])) / parentArea;
+					if (cost < bestCost) {
+						bestCost = cost;
+						bestAxis = axis;
+						bestBin = b;
+					}
+				}
+			}
+
+			const FP32 leafCost = SAH_INTERSECTION_COST * FP32(count);
+			if (bestAxis < 0 || (bestCost >= leafCost && count <= BVH_MAX_LEAF_SIZE)) return;
+
+			for (uint32_t b = 0; b < BVH_BIN_COUNT; ++b) {
+				const BuildBin& bin = bins.m_Bins[bestAxis][b];
+				if (b < bestBin) {
+					leftBounds.grow(bin.m_Bounds);
+					leftCentroids.grow(bin.m_CentroidBounds);
+					split += bin.m_Count;
+				} else {
+					rightBounds.grow(bin.m_Bounds);
+					rightCentroids.grow(bin.m_CentroidBounds);
+				}
+			}
+
+			const FP32 axisMin = ro_CentroidBounds.m_Min[bestAxis];
+			const FP32 axisScale = scale[bestAxis];
+			std::partition(prims + v_Begin, prims + v_End,
+						   [bestAxis, bestBin, axisMin, axisScale](const BuildPrimitive& ro_Prim) {
+							   return binIndex(ro_Prim.m_Centroid[bestAxis], axisMin, axisScale) < bestBin;
+						   });
+			split += v_Begin;
+		} else {
+			// Every centroid coincides, SAH has nothing to bin
+			if (count <= BVH_MAX_LEAF_SIZE) return;
+			split = v_Begin + count / 2;
+			computeBounds(prims, v_Begin, split, leftBounds, leftCentroids);
+			computeBounds(prims, split, v_End, rightBounds, rightCentroids);
+		}
+
+		const uint32_t leftChild = allocateNodePair(ro_Ctx);
+		node.m_Offset = leftChild;
+		node.m_Count = 0;
+
+		const bool forkRight = (v_End - split) >= BVH_PARALLEL_SUBTREE_THRESHOLD
+			&& ro_Ctx.m_IdleWorkers.fetch_sub(1, std::memory_order_acq_rel) > 0;
+
+		if (forkRight) {
+			std::thread worker([&ro_Ctx, leftChild, split, v_End, v_Depth, &rightBounds, &rightCentroids]() {
+				buildNode(ro_Ctx, leftChild + 1, split, v_End, v_Depth + 1, rightBounds, rightCentroids);
+			});
+			buildNode(ro_Ctx, leftChild, v_Begin, split, v_Depth + 1, leftBounds, leftCentroids);
+			worker.join();
+			ro_Ctx.m_IdleWorkers.fetch_add(1, std::memory_order_acq_rel);
+		} else {
+			if ((v_End - split) >= BVH_PARALLEL_SUBTREE_THRESHOLD)
+				ro_Ctx.m_IdleWorkers.fetch_add(1, std::memory_order_acq_rel);
+			buildNode(ro_Ctx, leftChild, v_Begin, split, v_Depth + 1, leftBounds, leftCentroids);
+			buildNode(ro_Ctx, leftChild + 1, split, v_End, v_Depth + 1, rightBounds, rightCentroids);
+		}
+	}
+
+	static void computeStats(const BVH& ro_BVH, BVHBuildStats& ro_Stats) {
+		ro_Stats.m_NodeCount = ro_BVH.m_NodeCount;
+		ro_Stats.m_LeafCount = 0;
+		ro_Stats.m_MaxDepth = 0;
+
+		const FP32 rootArea = ro_BVH.m_Nodes[0].m_Bounds.surfaceArea();
+		const FP32 invRootArea = rootArea > 0.0f ? 1.0f / rootArea : 0.0f;
+		double cost = 0.0;
+
+		struct Entry {
+			uint32_t m_Node;
+			uint32_t m_Depth;
+		};
+		std::vector<Entry> stack;
+		stack.push_back({ 0, 1 });
+		while (!stack.empty()) {
+			Entry e = stack.back();
+			stack.pop_back();
+			const BVHNode& node = ro_BVH.m_Nodes[e.m_Node];
+			ro_Stats.m_MaxDepth = std::max(ro_Stats.m_MaxDepth, e.m_Depth);
+			const double area = double(node.m_Bounds.surfaceArea()) * invRootArea;
+			if (node.isLeaf()) {
+				++ro_Stats.m_LeafCount;
+				cost += area * SAH_INTERSECTION_COST * node.m_Count;
+			} else {
+				cost += area * SAH_TRAVERSAL_COST;
+				stack.push_back({ node.m_Offset, e.m_Depth + 1 });
+				stack.push_back({ node.m_Offset + 1, e.m_Depth + 1 });
+			}
+		}
+		ro_Stats.m_SAHCost = static_cast<FP32>(cost);
+	}
+
+	BVH buildBVH(const GSphere* p_Spheres, size_t v_SphereCount, const GPlane* p_Planes, size_t v_PlaneCount,
+				 unsigned int v_ThreadCount) {
+		BVH bvh;
+		const size_t total = v_SphereCount + v_PlaneCount;
+		if (!total) return bvh;
+
+		const auto startTime = std::chrono::steady_clock::now();
+
+		if (!v_ThreadCount) v_ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		// 2N - 1 nodes at most, reserve once and commit as the build advances
+		if (!bvh.m_NodeArena.reserve(2 * total * sizeof(BVHNode))) return bvh;
+		bvh.m_NodeArena.adviseHugePages();
+		bvh.m_Nodes = bvh.m_NodeArena.data();
+
+		std::vector<BuildPrimitive> prims(total);
+		const uint32_t primCount = static_cast<uint32_t>(total);
+		const uint32_t sphereCount = static_cast<uint32_t>(v_SphereCount);
+
+		std::vector<AABB> chunkBounds(v_ThreadCount), chunkCentroids(v_ThreadCount);
+		parallelChunks(v_ThreadCount, 0, primCount, [&](uint32_t v_Chunk, uint32_t v_B, uint32_t v_E) {
+			for (uint32_t i = v_B; i < v_E; ++i) {
+				BuildPrimitive& prim = prims[i];
+				if (i < sphereCount) {
+					prim.m_Bounds = bounds(p_Spheres[i]);
+					prim.m_Ref = { i, PrimitiveType::Sphere };
+				} else {
+					prim.m_Bounds = bounds(p_Planes[i - sphereCount]);
+					prim.m_Ref = { i - sphereCount, PrimitiveType::Plane };
+				}
+				for (int a = 0; a < 3; ++a) prim.m_Centroid[a] = prim.m_Bounds.centroid(a);
+			}
+			computeBounds(prims.data(), v_B, v_E, chunkBounds[v_Chunk], chunkCentroids[v_Chunk]);
+		});
+
+		AABB rootBounds, rootCentroids;
+		for (unsigned int t = 0; t < v_ThreadCount; ++t) {
+			rootBounds.grow(chunkBounds[t]);
+			rootCentroids.grow(chunkCentroids[t]);
+		}
+
+		BuildContext ctx(prims, bvh, v_ThreadCount);
+		bvh.m_NodeArena.commitForward(std::min(kNodeCommitChunk, bvh.m_NodeArena.reservedCount()));
+		ctx.m_Committed.store(bvh.m_NodeArena.committedCount());
+		ctx.m_NextNode.store(1);
+
+		buildNode(ctx, 0, 0, primCount, 0, rootBounds, rootCentroids);
+		bvh.m_NodeCount = ctx.m_NextNode.load();
+
+		bvh.m_Primitives.resize(total);
+		for (size_t i = 0; i < total; ++i)
+			bvh.m_Primitives[i] = prims[i].m_Ref;
+
+		const auto endTime = std::chrono::steady_clock::now();
+		bvh.m_Stats.m_BuildMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		bvh.m_Stats.m_ThreadCount = v_ThreadCount;
+		computeStats(bvh, bvh.m_Stats);
+		return bvh;
+	}
+
+	// ----------------------------------------------------------------------------------
+	// Traversal
+	// ----------------------------------------------------------------------------------
+
+	// Entry distance into the box clipped to [0, v_TMax], INFINITY on a miss
+	static FP32 intersectBounds(const AABB& ro_Box, const FP32 (&ro_Origin)[3], const FP32 (&ro_InvDir)[3], FP32 v_TMax) {
+		FP32 tNear = 0.0f;
+		FP32 tFar = v_TMax;
+		for (int a = 0; a < 3; ++a) {
+			FP32 t0 = (ro_Box.m_Min[a] - ro_Origin[a]) * ro_InvDir[a];
+			FP32 t1 = (ro_Box.m_Max[a] - ro_Origin[a]) * ro_InvDir[a];
+			if (t0 > t1) std::swap(t0, t1);
+			// NaNs from 0 * inf fall through both comparisons and leave the interval untouched
+			tNear = std::max(tNear, t0);
+			tFar = std::min(tFar, t1);
+		}
+		return tNear <= tFar ? tNear : INFINITY;
+	}
+
+	// Linear scan order: spheres first, then planes, by index
+	static uint64_t orderKey(const PrimitiveRef& ro_Ref) {
+		return (uint64_t(ro_Ref.m_Type) << 32) | ro_Ref.m_Index;
+	}
+
+	void intersectPrimitives(const PrimitiveRef* p_Refs, uint32_t v_Count, const GSphere* p_Spheres, const GPlane* p_Planes,
+							 const Ray& ro_Ray, HitRecord& ro_Closest, uint64_t& ro_ClosestKey) {
+		for (uint32_t i = 0; i < v_Count; ++i) {
+			const PrimitiveRef& ref = p_Refs[i];
+			HitRecord h = ref.m_Type == PrimitiveType::Sphere
+				? hit(ro_Ray, p_Spheres[ref.m_Index])
+				: hit(ro_Ray, p_Planes[ref.m_Index]);
+			if (!h.m_Hit) continue;
+
+			const uint64_t key = orderKey(ref);
+			if (h.m_T < ro_Closest.m_T || (h.m_T == ro_Closest.m_T && key < ro_ClosestKey)) {
+				ro_Closest = h;
+				ro_ClosestKey = key;
+			}
+		}
+	}
+
+	HitRecord intersect(const BVH& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes, const Ray& ro_Ray) {
+		HitRecord closest = HitRecord::captureMiss();
+		if (ro_BVH.isEmpty()) return closest;
+
+		uint64_t closestKey = UINT64_MAX;
+
+		const FP32 origin[3] = { ro_Ray.m_Origin.X, ro_Ray.m_Origin.Y, ro_Ray.m_Origin.Z };
+		const FP32 invDir[3] = {
+			1.0f / ro_Ray.m_DirectionCosine.X,
+			1.0f / ro_Ray.m_DirectionCosine.Y,
+			1.0f / ro_Ray.m_DirectionCosine.Z };
+
+		struct StackEntry {
+			uint32_t m_Node;
+			FP32 m_TEntry;
+		};
+		StackEntry stack[BVH_MAX_DEPTH + 1];
+		uint32_t stackSize = 0;
+
+		FP32 rootT = intersectBounds(ro_BVH.m_Nodes[0].m_Bounds, origin, invDir, INFINITY);
+		if (rootT == INFINITY) return closest;
+		stack[stackSize++] = { 0, rootT };
+
+		while (stackSize) {
+			const StackEntry entry = stack[--stackSize];
+			// Everything behind the closest hit so far is culled
+			if (entry.m_TEntry > closest.m_T) continue;
+
+			const BVHNode& node = ro_BVH.m_Nodes[entry.m_Node];
+			if (node.isLeaf()) {
+				intersectPrimitives(ro_BVH.m_Primitives.data() + node.m_Offset, node.m_Count,
+									p_Spheres, p_Planes, ro_Ray, closest, closestKey);
+				continue;
+			}
+
+			const uint32_t left = node.m_Offset;
+			const uint32_t right = node.m_Offset + 1;
+			FP32 tLeft = intersectBounds(ro_BVH.m_Nodes[left].m_Bounds, origin, invDir, closest.m_T);
+			FP32 tRight = intersectBounds(ro_BVH.m_Nodes[right].m_Bounds, origin, invDir, closest.m_T);
+
+			// Push the far child first so the near child is popped next
+			if (tLeft <= tRight) {
+				if (tRight != INFINITY) stack[stackSize++] = { right, tRight };
+				if (tLeft != INFINITY) stack[stackSize++] = { left, tLeft };
+			} else {
+				if (tLeft != INFINITY) stack[stackSize++] = { left, tLeft };
+				if (tRight != INFINITY) stack[stackSize++] = { right, tRight };
+			}
+		}
+
+		return closest;
+	}
+
+	bool occludedPrimitives(const PrimitiveRef* p_Refs, uint32_t v_Count, const GSphere* p_Spheres, const GPlane* p_Planes,
+							const Ray& ro_Ray, FP32 v_TMax) {
+		for (uint32_t i = 0; i < v_Count; ++i) {
+			const PrimitiveRef& ref = p_Refs[i];
+			const bool blocked = ref.m_Type == PrimitiveType::Sphere
+				? occluded(ro_Ray, p_Spheres[ref.m_Index], v_TMax)
+				: occluded(ro_Ray, p_Planes[ref.m_Index], v_TMax);
+			if (blocked) return true;
+		}
+		return false;
+	}
+
+	bool occluded(const BVH& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes, const Ray& ro_Ray, FP32 v_TMax) {
+		if (ro_BVH.isEmpty()) return false;
+
+		const FP32 origin[3] = { ro_Ray.m_Origin.X, ro_Ray.m_Origin.Y, ro_Ray.m_Origin.Z };
+		const FP32 invDir[3] = {
+			1.0f / ro_Ray.m_DirectionCosine.X,
+			1.0f / ro_Ray.m_DirectionCosine.Y,
+			1.0f / ro_Ray.m_DirectionCosine.Z };
+
+		uint32_t stack[BVH_MAX_DEPTH + 1];
+		uint32_t stackSize = 0;
+
+		if (intersectBounds(ro_BVH.m_Nodes[0].m_Bounds, origin, invDir, v_TMax) == INFINITY) return false;
+		stack[stackSize++] = 0;
+
+		// No ordering, the first blocker found ends the walk
+		while (stackSize) {
+			const BVHNode& node = ro_BVH.m_Nodes[stack[--stackSize]];
+			if (node.isLeaf()) {
+				if (occludedPrimitives(ro_BVH.m_Primitives.data() + node.m_Offset, node.m_Count,
+									   p_Spheres, p_Planes, ro_Ray, v_TMax))
+					return true;
+				continue;
+			}
+
+			for (uint32_t child = node.m_Offset; child < node.m_Offset + 2; ++child) {
+				if (intersectBounds(ro_BVH.m_Nodes[child].m_Bounds, origin, invDir, v_TMax) != INFINITY)
+					stack[stackSize++] = child;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,39 @@
+#include <Core.h>
+#include <Camera.h>
+
+namespace WavefrontPT::Integrator {
+	using namespace WavefrontPT::Math;
+
+	Camera makeCamera(const CameraDesc& ro_Desc, Math::FP32 v_Aspect) {
+		const Math::FP32 halfHeight = std::tan(ro_Desc.m_VerticalFov * (std::numbers::pi_v<float> / 360.0f));
+		const Math::FP32 viewportHeight = 2.0f * halfHeight;
+		const Math::FP32 viewportWidth = viewportHeight * v_Aspect;
+
+		// Right-handed basis looking down -w
+		const Math::Vector3 w = Math::normalize(ro_Desc.m_Origin - ro_Desc.m_LookAt);
+		const Math::Vector3 u = Math::normalize(Math::cross(ro_Desc.m_Up, w));
+		const Math::Vector3 v = Math::cross(w, u);
+
+		const Math::Vector3 horizontal = Math::scale(u, viewportWidth);
+		const Math::Vector3 vertical = Math::scale(v, viewportHeight);
+		const Math::Point3 lowerLeft = ro_Desc.m_Origin
+			+ Math::negate(Math::scale(horizontal, 0.5f) + Math::scale(vertical, 0.5f) + w);
+
+		return Camera(ro_Desc.m_Origin, lowerLeft, horizontal, vertical);
+	}
+
+	Math::RayPacket generateCameraPacket(const Camera& ro_Camera, Math::RegFP32 v_U, Math::RegFP32 v_V, Math::RegFP32 v_Active) {
+		auto broadcast = [](const auto& ro_Vec) {
+			return Math::Stripe3(_mm256_set1_ps(ro_Vec.X), _mm256_set1_ps(ro_Vec.Y), _mm256_set1_ps(ro_Vec.Z));
+		};
+		const Math::Vector3 corner = ro_Camera.m_LowerLeftCorner - ro_Camera.m_Origin;
+
+		Math::RayPacket packet;
+		packet.m_Origin = broadcast(ro_Camera.m_Origin);
+		packet.m_Direction = Math::normalize(broadcast(corner)
+			+ Math::scale(broadcast(ro_Camera.m_Horizontal), v_U)
+			+ Math::scale(broadcast(ro_Camera.m_Vertical), v_V));
+		packet.m_Active = v_Active;
+		return packet;
+	}
+}
@@ -0,0 +1,87 @@
+#include <Core.h>
+#include <Checkpoint.h>
+#include <SceneLoader.h>
+
+#include <cstring>
+
+namespace WavefrontPT::Integrator {
+	static CheckpointHeader makeHeader(IntegratorMode v_Mode, const RenderSettings& ro_Settings) {
+		CheckpointHeader header{};
+		header.m_Magic = CHECKPOINT_MAGIC;
+		header.m_Version = CHECKPOINT_VERSION;
+		header.m_Width = ro_Settings.m_Width;
+		header.m_Height = ro_Settings.m_Height;
+		header.m_Mode = static_cast<uint32_t>(v_Mode);
+		header.m_MaxBounces = uint32_t(ro_Settings.m_MaxBounces);
+		header.m_RouletteDepth = uint32_t(ro_Settings.m_RouletteDepth);
+		header.m_AdaptiveThreshold = ro_Settings.m_AdaptiveThreshold;
+		header.m_PixelBytes = uint32_t(sizeof(Math::Vector3) + sizeof(PixelStats));
+		header.m_Sampler = static_cast<uint32_t>(ro_Settings.m_Sampler);
+
+		// The scene was loaded just before, an unreadable stamp only leaves the path hash to compare
+		SceneIdentity scene;
+		sceneIdentity(ro_Settings.m_ScenePath, scene);
+		header.m_ScenePathHash = scene.m_PathHash;
+		header.m_SceneBytes = scene.m_SourceBytes;
+		header.m_SceneTime = scene.m_SourceTime;
+		return header;
+	}
+
+	// The target sample count and pass size are left out on purpose, a finished render can be extended
+	static bool sameRender(const CheckpointHeader& ro_A, const CheckpointHeader& ro_B) {
+		return ro_A.m_Magic == ro_B.m_Magic && ro_A.m_Version == ro_B.m_Version
+			&& ro_A.m_Width == ro_B.m_Width && ro_A.m_Height == ro_B.m_Height
+			&& ro_A.m_Mode == ro_B.m_Mode && ro_A.m_MaxBounces == ro_B.m_MaxBounces
+			&& ro_A.m_RouletteDepth == ro_B.m_RouletteDepth
+			&& ro_A.m_AdaptiveThreshold == ro_B.m_AdaptiveThreshold && ro_A.m_PixelBytes == ro_B.m_PixelBytes
+			&& ro_A.m_Sampler == ro_B.m_Sampler && ro_A.m_ScenePathHash == ro_B.m_ScenePathHash
+			&& ro_A.m_SceneBytes == ro_B.m_SceneBytes && ro_A.m_SceneTime == ro_B.m_SceneTime;
+	}
+
+	bool Checkpoint::open(const char* p_Path, IntegratorMode v_Mode, const RenderSettings& ro_Settings,
+						  AccumulationBuffer& ro_Buffer, bool& ro_Resumed) {
+		static_assert(sizeof(CheckpointHeader) <= Memory::PAGE_FILE);
+
+		ro_Resumed = false;
+		m_PixelCount = ro_Buffer.pixelCount();
+		m_SlotBytes = Memory::alignToPage(m_PixelCount * (sizeof(Math::Vector3) + sizeof(PixelStats)));
+		const size_t fileBytes = Memory::PAGE_FILE + 2 * m_SlotBytes;
+		const CheckpointHeader expected = makeHeader(v_Mode, ro_Settings);
+
+		if (m_File.open(p_Path, true)) {
+			const CheckpointHeader& found = header();
+			if (m_File.size() == fileBytes && sameRender(found, expected) && found.m_Published && found.m_Published <= 2) {
+				const std::byte* src = slot(found.m_Published - 1);
+				std::memcpy(ro_Buffer.m_Sum, src, m_PixelCount * sizeof(Math::Vector3));
+				std::memcpy(ro_Buffer.m_Stats, src + m_PixelCount * sizeof(Math::Vector3), m_PixelCount * sizeof(PixelStats));
+				ro_Resumed = true;
+				return true;
+			}
+			m_File.close();
+		}
+
+		// Missing, stale or from another render: start over
+		if (!m_File.create(p_Path, fileBytes)) return false;
+		header() = expected;
+		return true;
+	}
+
+	bool Checkpoint::save(const AccumulationBuffer& ro_Buffer, uint32_t v_SamplesDone, uint32_t v_Passes) {
+		if (!m_File.isOpen()) return false;
+
+		CheckpointHeader& h = header();
+		const uint32_t target = h.m_Published == 1 ? 1 : 0;
+		std::byte* dst = slot(target);
+		std::memcpy(dst, ro_Buffer.m_Sum, m_PixelCount * sizeof(Math::Vector3));
+		std::memcpy(dst + m_PixelCount * sizeof(Math::Vector3), ro_Buffer.m_Stats, m_PixelCount * sizeof(PixelStats));
+
+		h.m_SlotSamples[target] = v_SamplesDone;
+		h.m_SlotPasses[target] = v_Passes;
+
+		// The slot has to be on disk before the header points at it, the header itself can trail
+		if (!m_File.flush(size_t(dst - m_File.data()), m_SlotBytes, true)) return false;
+
+		h.m_Published = target + 1;
+		return m_File.flush(0, Memory::PAGE_FILE, false);
+	}
+}
@@ -0,0 +1,179 @@
+#include <Core.h>
+#include <FileOutput.h>
+
+#include <cstring>
+
+#include "Functions.h"
+#include "MappedFile.h"
+
+namespace WavefrontPT::Output {
+	using namespace WavefrontPT::Math;
+
+#if !defined(EDITOR_MODE) && !defined(__AVX2__)
+#error "AVX2 flag must be enabled to use vectorized operations"
+#else
+	// Pixels per quantization step, two padded Vector3 per register
+	constexpr size_t kQuantizeBlock = 8;
+
+	// log2 for x > 0: exponent plus atanh series of the mantissa folded into [sqrt(1/2), sqrt(2)),
+	// truncation error is below 1e-8 which is far under half an 8-bit step
+	static Reg8 log2Approx(const Reg8& r_X) {
+		const __m256i bits = _mm256_castps_si256(r_X);
+		const __m256i exponent = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+		Reg8 mantissa = _mm256_castsi256_ps(_mm256_or_si256(
+			_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+		const Reg8 fold = _mm256_cmp_ps(mantissa, _mm256_set1_ps(std::numbers::sqrt2_v<float>), _CMP_GT_OQ);
+		mantissa = _mm256_blendv_ps(mantissa, _mm256_mul_ps(mantissa, _mm256_set1_ps(0.5f)), fold);
+		const Reg8 e = _mm256_add_ps(_mm256_cvtepi32_ps(exponent), _mm256_and_ps(fold, _mm256_set1_ps(1.0f)));
+
+		const Reg8 one = _mm256_set1_ps(1.0f);
+		const Reg8 t = _mm256_div_ps(_mm256_sub_ps(mantissa, one), _mm256_add_ps(mantissa, one));
+		const Reg8 t2 = _mm256_mul_ps(t, t);
+		Reg8 series = _mm256_set1_ps(1.0f / 9.0f);
+		series = _mm256_fmadd_ps(series, t2, _mm256_set1_ps(1.0f / 7.0f));
+		series = _mm256_fmadd_ps(series, t2, _mm256_set1_ps(1.0f / 5.0f));
+		series = _mm256_fmadd_ps(series, t2, _mm256_set1_ps(1.0f / 3.0f));
+		series = _mm256_fmadd_ps(series, t2, one);
+
+		return _mm256_fmadd_ps(_mm256_mul_ps(series, t), _mm256_set1_ps(2.0f * std::numbers::log2e_v<float>), e);
+	}
+
+	// 2^y for y in (-126, 0]: integer part into the exponent, Taylor series on the fraction in [-1/2, 1/2]
+	static Reg8 exp2Approx(const Reg8& r_Y) {
+		const Reg8 n = _mm256_round_ps(r_Y, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		const Reg8 f = _mm256_mul_ps(_mm256_sub_ps(r_Y, n), _mm256_set1_ps(std::numbers::ln2_v<float>));
+
+		Reg8 p = _mm256_set1_ps(1.0f / 720.0f);
+		p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f / 120.0f));
+		p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f / 24.0f));
+		p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f / 6.0f));
+		p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(0.5f));
+		p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f));
+		p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f));
+
+		const __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+		return _mm256_mul_ps(p, _mm256_castsi256_ps(scale));
+	}
+
+	// Linear to sRGB code values in [0, 255], still as int32 lanes
+	static __m256i encodeSRGB(const Reg8& r_Linear) {
+		// max returns the second operand for NaN, so NaN lands on 0
+		const Reg8 x = _mm256_min_ps(_mm256_max_ps(r_Linear, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+
+		const Reg8 curve = _mm256_fmsub_ps(_mm256_set1_ps(1.055f),
+			exp2Approx(_mm256_mul_ps(log2Approx(x), _mm256_set1_ps(1.0f / 2.4f))), _mm256_set1_ps(0.055f));
+		const Reg8 linear = _mm256_mul_ps(x, _mm256_set1_ps(12.92f));
+		const Reg8 srgb = _mm256_blendv_ps(curve, linear, _mm256_cmp_ps(x, _mm256_set1_ps(0.0031308f), _CMP_LE_OQ));
+
+		return _mm256_cvtps_epi32(_mm256_mul_ps(srgb, _mm256_set1_ps(255.0f)));
+	}
+
+	// Eight padded pixels to 24 packed RGB bytes
+	static void quantizeBlock(const Math::Vector3* p_Pixels, uint8_t* p_Out) {
+		const __m256i c01 = encodeSRGB(_mm256_loadu_ps(&p_Pixels[0].X));
+		const __m256i c23 = encodeSRGB(_mm256_loadu_ps(&p_Pixels[2].X));
+		const __m256i c45 = encodeSRGB(_mm256_loadu_ps(&p_Pixels[4].X));
+		const __m256i c67 = encodeSRGB(_mm256_loadu_ps(&p_Pixels[6].X));
+
+		// Packing works per 128-bit lane: the low lane ends up holding pixels 0 2 4 6 and the high lane 1 3 5 7
+		const __m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(c01, c23), _mm256_packus_epi32(c45, c67));
+		const __m256i ordered = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+
+		// Drop the padding byte of every pixel, then close the gap between the two lanes
+		const __m256i dropPad = _mm256_setr_epi8(
+			0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+			0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+		const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(ordered, dropPad),
+														   _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p_Out), _mm256_castsi256_si128(packed));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(p_Out + 16), _mm256_extracti128_si256(packed, 1));
+	}
+
+	void quantizeSRGB8(const Math::Vector3* p_Pixels, size_t v_Count, uint8_t* p_Out) {
+		size_t i = 0;
+		for (; i + kQuantizeBlock <= v_Count; i += kQuantizeBlock)
+			quantizeBlock(p_Pixels + i, p_Out + 3 * i);
+
+		// The tail goes through the same kernel so every pixel rounds identically
+		if (i < v_Count) {
+			Math::Vector3 pixels[kQuantizeBlock];
+			uint8_t bytes[3 * kQuantizeBlock];
+			const size_t rest = v_Count - i;
+			for (size_t k = 0; k < kQuantizeBlock; ++k)
+				pixels[k] = k < rest ? p_Pixels[i + k] : Math::Vector3(0.0f);
+			quantizeBlock(pixels, bytes);
+			std::memcpy(p_Out + 3 * i, bytes, 3 * rest);
+		}
+	}
+#endif
+
+	// Splits [0, v_Rows) into contiguous runs, one per hardware thread
+	template<typename RowFn>
+	static void forEachRow(size_t v_Rows, const RowFn& ro_Fn) {
+		const size_t workerCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+													std::max<size_t>(1, v_Rows / OUTPUT_MIN_ROWS_PER_WORKER));
+		if (workerCount == 1) {
+			for (size_t row = 0; row < v_Rows; ++row) ro_Fn(row);
+			return;
+		}
+
+		std::vector<std::thread> workers;
+		for (size_t w = 0; w < workerCount; ++w) {
+			workers.emplace_back([&, w]() {
+				const size_t end = v_Rows * (w + 1) / workerCount;
+				for (size_t row = v_Rows * w / workerCount; row < end; ++row) ro_Fn(row);
+			});
+		}
+		for (auto& w : workers)
+			w.join();
+	}
+
+	// Fills the payload straight into a mapped file, or into one buffer and a single write if mapping fails
+	template<typename FillFn>
+	static bool writeImage(const char* p_Filename, const std::string& ro_Header, size_t v_PayloadBytes, const FillFn& ro_Fill) {
+		const size_t fileBytes = ro_Header.size() + v_PayloadBytes;
+
+		Memory::MappedFile file;
+		if (file.create(p_Filename, fileBytes)) {
+			std::memcpy(file.data(), ro_Header.data(), ro_Header.size());
+			ro_Fill(reinterpret_cast<uint8_t*>(file.data() + ro_Header.size()));
+			return true;
+		}
+
+		std::vector<uint8_t> buffer(fileBytes);
+		std::memcpy(buffer.data(), ro_Header.data(), ro_Header.size());
+		ro_Fill(buffer.data() + ro_Header.size());
+
+		std::ofstream out(p_Filename, std::ios::out | std::ios::binary);
+		out.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+		return bool(out);
+	}
+
+	bool writePPM(const char* p_Filename, const Math::Vector3* p_Image, size_t v_Width, size_t v_Height) {
+		const std::string header = "P6\n" + std::to_string(v_Width) + " " + std::to_string(v_Height) + "\n255\n";
+		const size_t rowBytes = 3 * v_Width;
+
+		return writeImage(p_Filename, header, rowBytes * v_Height, [&](uint8_t* p_Payload) {
+			forEachRow(v_Height, [&](size_t v_Row) {
+				quantizeSRGB8(p_Image + (v_Height - 1 - v_Row) * v_Width, v_Width, p_Payload + v_Row * rowBytes);
+			});
+		});
+	}
+
+	bool writePFM(const char* p_Filename, const Math::Vector3* p_Image, size_t v_Width, size_t v_Height) {
+		// A negative scale marks the samples as little-endian
+		const std::string header = "PF\n" + std::to_string(v_Width) + " " + std::to_string(v_Height) + "\n-1.0\n";
+		const size_t rowBytes = 3 * sizeof(float) * v_Width;
+
+		return writeImage(p_Filename, header, rowBytes * v_Height, [&](uint8_t* p_Payload) {
+			forEachRow(v_Height, [&](size_t v_Row) {
+				const Math::Vector3* src = p_Image + v_Row * v_Width;
+				uint8_t* dst = p_Payload + v_Row * rowBytes;
+				for (size_t x = 0; x < v_Width; ++x)
+					std::memcpy(dst + x * 3 * sizeof(float), &src[x].X, 3 * sizeof(float));
+			});
+		});
+	}
+}
@@ -1,106 +1,312 @@
 #include <Core.h>
 #include <IntegratorMathCore.h>
 #include <Integrators.h>
+#include <bit>
 #include <iostream>
 #include <WMath.h>
 
+#include "Accumulation.h"
+#include "Camera.h"
+#include "Checkpoint.h"
 #include "FileOutput.h"
+#include "FrameArena.h"
 #include "IntegratorOps.h"
 #include "Payload.h"
+#include "RenderStats.h"
 #include "Scene.h"
+#include "SceneLoader.h"
+#include "TileScheduler.h"
+#include "Wavefront.h"
 
 namespace WavefrontPT::Integrator {
 	using namespace WavefrontPT::Math;
 
-	static Vector3 traceRay(const Scene& ro_Scene, const Math::Ray& ro_Ray, int v_MaxBounce, int v_Seed) {
+	// ro_FirstHit is the camera ray's closest hit, traced beforehand with its packet
+	static Vector3 traceRay(const Scene& ro_Scene, const Math::Ray& ro_Ray, const Math::HitRecord& ro_FirstHit,
+							int v_MaxBounce, int v_RouletteDepth, const Integrators::Ops::PathSampler& ro_Sampler) {
 		Payload payload(ro_Ray);
-		payload.m_RngState = v_Seed;
+		payload.m_Sampler = ro_Sampler;
 		for (int bounce = 0; bounce < v_MaxBounce; bounce++) {
-			Math::HitRecord hit = hitScene(ro_Scene, payload.m_CurrentRay);
+			if (bounce > 0) ++t_RayCounters.m_ExtensionRays;
+			Math::HitRecord hit = bounce > 0 ? hitScene(ro_Scene, payload.m_CurrentRay) : ro_FirstHit;
 			if (!hit.m_Hit) {
-				payload.m_Radiance = payload.m_Radiance + payload.m_Throughput * Vector3(.1f, .1f, .1f);
+				shadeMiss(payload);
 				break;
 			}
 			const Materials::Material& mat = ro_Scene.m_Materials[hit.m_MatID];
 			evaluateMaterialResponse(ro_Scene, payload, hit, mat);
 			if (maxFast(payload.m_Throughput.X,
-						maxFast(payload.m_Throughput.Y, payload.m_Throughput.Z)) < kEpsilon)
+						maxFast(payload.m_Throughput.Y, payload.m_Throughput.Z)) < kEpsilon) {
+				// Emitters zero the throughput as well, shadeEmission has counted them
+				WF_PROFILE_COUNT(m_TerminatedThroughput, Materials::classify(mat) != Materials::MaterialClass::Emissive ? 1 : 0);
 				break;
+			}
+			if (rouletteAfter(bounce, v_RouletteDepth, v_MaxBounce) && !surviveRoulette(payload))
+				break;
+			if (bounce + 1 == v_MaxBounce) WF_PROFILE_COUNT(m_TerminatedMaxBounce, 1);
 		}
 		return payload.m_Radiance;
 	}
 
-	static void renderRows(
+	// Adds samples [sampleBegin, sampleEnd) of every unconverged pixel in the tile to the accumulation.
+	// Camera rays go out as one packet per 4x2 block and sample, each lane then continues on its own
+	static void renderTile(
 		const Scene& scene,
-		Vector3* framebuffer,
-		size_t yStart,
-		size_t yEnd,
+		AccumulationBuffer& accumulation,
+		const Threading::Tile& tile,
 		size_t width,
 		size_t height,
+		int sampleBegin,
+		int sampleEnd,
 		int maxBounces,
-		const Point3& cameraOrigin,
-		const Point3& lowerLeftCorner,
-		const Vector3& horizontal,
-		const Vector3& vertical) {
-		constexpr int kSamplesPerPixel = 128;
+		int rouletteDepth,
+		FP32 adaptiveThreshold,
+		Integrators::Ops::SamplerType sampler,
+		const Camera& camera) {
+		Math::RayPacket packet;
+		Math::PacketHit hits;
+		uint32_t pixels[Math::RAY_PACKET_WIDTH];
+
+		const uint32_t blockCount = cameraBlockCount(tile);
+		for (uint32_t block = 0; block < blockCount; ++block) {
+			for (int s = sampleBegin; s < sampleEnd; ++s) {
+				uint32_t active = traceCameraPacket(scene, camera, accumulation.m_Stats, width, height, tile, block, s,
+													sampler, pixels, packet, hits);
+				for (; active; active &= active - 1) {
+					const uint32_t lane = static_cast<uint32_t>(std::countr_zero(active));
+					const uint32_t pixel = pixels[lane];
+
+					Vector3 radiance = traceRay(scene, Math::laneRay(packet, lane), Math::laneHit(hits, lane), maxBounces, rouletteDepth,
+												pathSampler(sampler, pixel, s));
+					accumulation.m_Sum[pixel] = accumulation.m_Sum[pixel] + radiance;
+					addSample(accumulation.m_Stats[pixel], radiance);
+				}
+			}
+		}
 
-		for (size_t y = yStart; y < yEnd; ++y) {
-			for (size_t x = 0; x < width; ++x) {
-				Vector3 accumulated(0.0f);
+		for (size_t y = tile.m_Y0; y < tile.m_Y1; ++y)
+			for (size_t x = tile.m_X0; x < tile.m_X1; ++x)
+				testConvergence(accumulation.m_Stats[y * width + x], adaptiveThreshold);
+	}
 
-				for (int s = 0; s < kSamplesPerPixel; ++s) {
-					uint32_t seed = (x + y * width) * 9781u + s * 6271u + 1u;
-					uint32_t jitterSeed = seed;
+	static unsigned int workerCount(const RenderSettings& ro_Settings) {
+		return ro_Settings.m_Threads ? ro_Settings.m_Threads : std::max(1u, std::thread::hardware_concurrency());
+	}
 
-					FP32 u = (FP32(x) + Integrators::Ops::randomFloat(jitterSeed)) / FP32(width);
-					FP32 v = (FP32(y) + Integrators::Ops::randomFloat(jitterSeed)) / FP32(height);
+	// One pass over every tile, samples [v_SampleBegin, v_SampleEnd) are added to ro_Accumulation
+	static void renderPass(
+		IntegratorMode v_Mode,
+		const RenderSettings& ro_Settings,
+		const Scene& ro_Scene,
+		const Camera& ro_Camera,
+		AccumulationBuffer& ro_Accumulation,
+		int v_SampleBegin,
+		int v_SampleEnd,
+		std::vector<Memory::FrameArena>& ro_Arenas,
+		std::vector<RayCounters>& ro_Counters,
+		uint32_t& ro_Steals) {
+		const size_t width = ro_Settings.m_Width;
+		const size_t height = ro_Settings.m_Height;
+		const unsigned int threadCount = unsigned(ro_Arenas.size());
+
+		Threading::TileScheduler scheduler(uint32_t(width), uint32_t(height), threadCount);
 
-					Point3 pixelPoint = lowerLeftCorner + scale(horizontal, u) + scale(vertical, v);
-					Vector3 rayDir = normalize(pixelPoint - cameraOrigin);
+		std::vector<std::thread> workers;
+		for (unsigned int t = 0; t < threadCount; ++t) {
+			workers.emplace_back([&, t]() {
+				t_RayCounters = {};
+				WF_PROFILE_BEGIN();
+				Threading::Tile tile;
+				while (scheduler.next(t, tile)) {
+					if (v_Mode == IntegratorMode::Wavefront)
+						renderWavefrontTile(ro_Arenas[t], ro_Scene, ro_Accumulation, tile, width, height,
+											v_SampleBegin, v_SampleEnd, ro_Settings.m_MaxBounces, ro_Settings.m_RouletteDepth,
+											ro_Settings.m_AdaptiveThreshold, ro_Settings.m_Sampler, ro_Settings.m_SortRays, ro_Camera);
+					else
+						renderTile(ro_Scene, ro_Accumulation, tile, width, height,
+								   v_SampleBegin, v_SampleEnd, ro_Settings.m_MaxBounces, ro_Settings.m_RouletteDepth,
+								   ro_Settings.m_AdaptiveThreshold, ro_Settings.m_Sampler, ro_Camera);
+				}
+				WF_PROFILE_END();
+				ro_Counters[t] += t_RayCounters;
+			});
+		}
 
-					Math::Ray cameraRay(cameraOrigin, rayDir);
+		for (auto& w : workers)
+			w.join();
 
-					Vector3 radiance = traceRay(scene, cameraRay, maxBounces, seed);
-					accumulated = accumulated + radiance;
-				}
-				framebuffer[y * width + x] = scale(accumulated, 1.0f / FP32(kSamplesPerPixel));
+		ro_Steals += scheduler.stealCount();
+	}
+
+	static void renderImage(
+		IntegratorMode v_Mode,
+		const RenderSettings& ro_Settings,
+		const Scene& ro_Scene,
+		const Camera& ro_Camera,
+		const std::string& ro_OutputName) {
+		const std::string imageFilename = ro_OutputName + ".ppm";
+		const size_t width = ro_Settings.m_Width;
+		const size_t height = ro_Settings.m_Height;
+		const size_t pixelCount = width * height;
+
+		AccumulationBuffer accumulation;
+		Memory::ArenaWalker<Vector3> imageArena;
+		if (!accumulation.initialize(width, height) || !imageArena.reserve(pixelCount * sizeof(Vector3))) return;
+		imageArena.adviseHugePages();
+		Vector3* image = imageArena.commitForward(pixelCount);
+		if (!image) return;
+
+		const unsigned int threadCount = workerCount(ro_Settings);
+
+		std::vector<RayCounters> counters(threadCount);
+		std::vector<Memory::FrameArena> arenas(threadCount);
+		if (v_Mode == IntegratorMode::Wavefront) {
+			for (Memory::FrameArena& arena : arenas)
+				if (!arena.reserve(Memory::FRAME_ARENA_RESERVE)) return;
+		}
+
+		const int targetSamples = ro_Settings.m_SamplesPerPixel;
+		const bool adaptive = ro_Settings.m_AdaptiveThreshold > 0.0f;
+		// Adaptive sampling and the time budget need passes to act on, the first one doubles as the warm-up
+		const int passSamples = ro_Settings.m_PassSamples > 0
+			? std::min(ro_Settings.m_PassSamples, targetSamples)
+			: adaptive ? std::min(ADAPTIVE_DEFAULT_PASS_SAMPLES, targetSamples)
+			: ro_Settings.m_TimeBudgetMs > 0.0 ? std::min(BUDGET_DEFAULT_PASS_SAMPLES, targetSamples)
+			: targetSamples;
+		size_t converged = 0;
+
+		int samplesDone = 0;
+		int passes = 0;
+		uint32_t steals = 0;
+		double lastPassMs = 0.0;
+
+		Checkpoint checkpoint;
+		if (ro_Settings.m_Checkpoint) {
+			bool resumed = false;
+			if (!checkpoint.open((ro_OutputName + ".ckpt").c_str(), v_Mode, ro_Settings, accumulation, resumed))
+				std::cout << "  Checkpoint: could not map " << ro_OutputName << ".ckpt, continuing without\n";
+			else if (resumed) {
+				samplesDone = int(checkpoint.samplesDone());
+				passes = int(checkpoint.passes());
+				std::cout << "  Checkpoint: resumed after pass " << passes << " at " << samplesDone << " spp\n";
 			}
 		}
-	}
 
-	void basicShadingIntegrator() {
-		// -------------------------------------------------
-		// Image
-		// -------------------------------------------------
-		constexpr size_t kImageWidth = 1920;
-		constexpr size_t kImageHeight = 1080;
+		auto startTime = std::chrono::steady_clock::now();
+
+		while (samplesDone < targetSamples) {
+			const double elapsedMs = std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - startTime).count();
+			// Skip a pass that would overrun the budget, the first one always runs
+			if (ro_Settings.m_TimeBudgetMs > 0.0 && passes > 0
+				&& elapsedMs + lastPassMs > ro_Settings.m_TimeBudgetMs)
+				break;
 
-		Vector3* framebuffer = new Vector3[kImageWidth * kImageHeight];
+			const int sampleEnd = std::min(samplesDone + passSamples, targetSamples);
+			const auto passStart = std::chrono::steady_clock::now();
+			renderPass(v_Mode, ro_Settings, ro_Scene, ro_Camera, accumulation,
+					   samplesDone, sampleEnd, arenas, counters, steals);
+			lastPassMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - passStart).count();
 
-		// -------------------------------------------------
-		// Camera (pinhole, scalar, no matrices)
-		// -------------------------------------------------
-		Point3 cameraOrigin(0.0f, 0.0f, 0.0f);
+			samplesDone = sampleEnd;
+			++passes;
 
-		FP32 aspect = FP32(kImageWidth) / FP32(kImageHeight);
+			if (checkpoint.isOpen() && !checkpoint.save(accumulation, uint32_t(samplesDone), uint32_t(passes)))
+				std::cout << "  Checkpoint: failed to publish pass " << passes << "\n";
 
-		FP32 viewportHeight = 2.0f;
-		FP32 viewportWidth = viewportHeight * aspect;
+			if (ro_Settings.m_DumpEvery > 0 && passes % ro_Settings.m_DumpEvery == 0 && samplesDone < targetSamples) {
+				resolve(accumulation, image);
+				Output::writePPM(imageFilename.c_str(), image, width, height);
+			}
 
-		FP32 focalLength = 1.0f;
+			if (adaptive) {
+				converged = 0;
+				for (size_t i = 0; i < pixelCount; ++i)
+					converged += accumulation.m_Stats[i].m_Converged;
+				if (converged == pixelCount) break;
+			}
+		}
 
-		Vector3 horizontal(viewportWidth, 0.0f, 0.0f);
-		Vector3 vertical(0.0f, viewportHeight, 0.0f);
+		auto endTime = std::chrono::steady_clock::now();
 
-		Point3 lowerLeftCorner =
-			cameraOrigin +
-			Vector3(-viewportWidth * 0.5f,
-					-viewportHeight * 0.5f,
-					-focalLength);
+		RayCounters total;
+		for (const RayCounters& c : counters)
+			total += c;
 
-		Scene scene;
+		const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+		std::cout << (v_Mode == IntegratorMode::Wavefront ? "[Wavefront] " : "[Megakernel] ")
+			<< "Time: "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(
+				endTime - startTime).count()
+			<< " ms\n";
+		std::cout << "  Passes: " << passes << ", " << samplesDone << " / " << targetSamples << " spp, "
+			<< (ro_Settings.m_Sampler == Integrators::Ops::SamplerType::Sobol ? "Sobol" : "white noise") << " sampler\n";
+		if (adaptive) {
+			uint64_t samples = 0;
+			for (size_t i = 0; i < pixelCount; ++i)
+				samples += accumulation.m_Stats[i].m_Samples;
+			std::cout << "  Adaptive: " << converged << " / " << pixelCount << " pixels converged, "
+				<< double(samples) / double(pixelCount) << " spp average\n";
+		}
+		std::cout << "  Rays: " << total.total()
+			<< " (camera " << total.m_CameraRays
+			<< ", extension " << total.m_ExtensionRays
+			<< ", shadow " << total.m_ShadowRays << ")\n";
+		// Every path starts with one camera ray and adds one extension ray per further segment
+		std::cout << "  Path length: "
+			<< (total.m_CameraRays ? double(total.m_CameraRays + total.m_ExtensionRays) / double(total.m_CameraRays) : 0.0)
+			<< " segments average, ";
+		// Only the length of this render is known, WavefrontPTBench measures it with and without roulette
+		if (ro_Settings.m_RouletteDepth > 0)
+			std::cout << "roulette from bounce " << ro_Settings.m_RouletteDepth << " ("
+				<< total.m_RouletteTerminations << " paths terminated)\n";
+		else
+			std::cout << "roulette off\n";
+		std::cout << "  Camera packets: " << total.m_CameraPackets << ", "
+			<< (total.m_CameraPackets ? double(total.m_CameraRays) / double(total.m_CameraPackets) : 0.0) << " rays per packet\n";
+		std::cout << "  Tiles: " << Threading::tileCount(uint32_t(width), uint32_t(height))
+			<< " per pass (" << steals << " stolen)\n";
+		if (v_Mode == IntegratorMode::Wavefront) {
+			size_t highWater = 0;
+			for (const Memory::FrameArena& arena : arenas)
+				highWater = std::max(highWater, arena.highWaterBytes());
+			std::cout << "  Frame arena high-water: " << highWater / 1024 << " KiB per worker\n";
+
+			const double extensionSeconds = double(total.m_ExtensionNs) * 1e-9;
+			std::cout << "  Extension pass: " << (extensionSeconds > 0.0 ? double(total.m_ExtensionRays) / extensionSeconds * 1e-6 : 0.0)
+				<< " Mrays/s, ";
+			if (total.m_CountedExtensionRays)
+				std::cout << double(total.m_ExtensionCacheMisses) / double(total.m_CountedExtensionRays) << " cache misses per ray\n";
+			else
+				std::cout << "cache misses unavailable\n";
+			if (ro_Settings.m_SortRays)
+				std::cout << "  Ray sort: " << total.m_SortedRays << " rays in " << double(total.m_SortNs) * 1e-6 << " ms\n";
+		}
+		std::cout << "  Mrays/s: " << (seconds > 0.0 ? double(total.total()) / seconds * 1e-6 : 0.0) << "\n";
+		if constexpr (PROFILE_ENABLED) {
+			const ProfileCounters& profile = total.m_Profile;
+			const double cycles = double(std::max<uint64_t>(1, profile.totalCycles()));
+			std::cout << "  Stage cycles: camera " << 100.0 * double(profile.m_StageCycles[uint32_t(ProfileStage::Camera)]) / cycles
+				<< "%, extension " << 100.0 * double(profile.m_StageCycles[uint32_t(ProfileStage::Extension)]) / cycles
+				<< "%, shading " << 100.0 * double(profile.m_StageCycles[uint32_t(ProfileStage::Shading)]) / cycles
+				<< "%, shadow " << 100.0 * double(profile.m_StageCycles[uint32_t(ProfileStage::Shadow)]) / cycles
+				<< "%, other " << 100.0 * double(profile.m_StageCycles[uint32_t(ProfileStage::Other)]) / cycles << "%\n";
+			if (!writeProfileReport(ro_OutputName, v_Mode == IntegratorMode::Wavefront ? "wavefront" : "megakernel", total, seconds))
+				std::cout << "  Profile: could not write " << ro_OutputName << "_profile.json/.csv\n";
+		}
+
+		resolve(accumulation, image);
+		Output::writePPM(imageFilename.c_str(), image, width, height);
+		if (ro_Settings.m_WritePfm)
+			Output::writePFM((ro_OutputName + ".pfm").c_str(), image, width, height);
+		if (ro_Settings.m_WriteHeatmap)
+			writeSampleHeatmap((ro_OutputName + "_samples.ppm").c_str(), accumulation, image);
+	}
+
+	// Built-in scene used when no --scene is given, scenes/demo.scene describes the same one
+	void buildDemoScene(Scene& ro_Scene) {
 		Math::MaterialID lightMat = registerMaterial(
-			scene,
+			ro_Scene,
 			Materials::Material(
 				Vector3(1.f, 1.f, 1.f),   // color (irrelevant for emission)
 				Vector3(18.0f, 15.f, 2.0f), // emission
@@ -110,7 +316,7 @@ namespace WavefrontPT::Integrator {
 		);
 
 		Math::MaterialID groundMat = registerMaterial(
-			scene,
+			ro_Scene,
 			Materials::Material(
 				Vector3(0.8f, 0.8f, 0.8f),   // diffuse reflectance
 				Vector3(0.0f, 0.0f, 0.0f),   // no emission
@@ -120,7 +326,7 @@ namespace WavefrontPT::Integrator {
 		);
 
 		Math::MaterialID metalMat = registerMaterial(
-			scene,
+			ro_Scene,
 			Materials::Material(
 				Vector3(0.9f, 0.9f, 0.9f),
 				Vector3(0.0f, 0.0f, 0.0f),
@@ -130,7 +336,7 @@ namespace WavefrontPT::Integrator {
 		);
 
 		Math::MaterialID redMat = registerMaterial(
-			scene,
+			ro_Scene,
 			Materials::Material(
 				Vector3(0.9f, 0.2f, 0.2f),
 				Vector3(0.0f, 0.0f, 0.0f),
@@ -140,7 +346,7 @@ namespace WavefrontPT::Integrator {
 		);
 
 		addPlane(
-			scene,
+			ro_Scene,
 			Geometry::GPlane(
 				Point3(0.0f, -1.0f, -5.0f),   // center
 				Vector3(0.0f, 1.0f, 0.0f),  // normal (up)
@@ -149,99 +355,122 @@ namespace WavefrontPT::Integrator {
 				20.0f,                        // half width
 				20.0f,                        // half breadth
 				groundMat,                     // material ID
-				scene.m_PlaneCount
+				ro_Scene.m_PlaneCount
 			)
 		);
 
 		addSphere(
-			scene,
+			ro_Scene,
 			Geometry::GSphere(
 				Point3(0.0f, 3.0f, -6.0f),
 				0.75f,
 				lightMat,
-				scene.m_SphereCount
+				ro_Scene.m_SphereCount
 			)
 		);
 
 		addSphere(
-			scene,
+			ro_Scene,
 			Geometry::GSphere(
 				Point3(0.0f, -0.25f, -4.0f),
 				0.75f,
 				metalMat,
-				scene.m_SphereCount
+				ro_Scene.m_SphereCount
 			)
 		);
 
 		addSphere(
-			scene,
+			ro_Scene,
 			Geometry::GSphere(
 				Point3(-2.0f, -0.25f, -5.0f),
 				0.75f,
 				redMat,
-				scene.m_SphereCount
+				ro_Scene.m_SphereCount
 			)
 		);
 
 		addSphere(
-			scene,
+			ro_Scene,
 			Geometry::GSphere(
 				Point3(2.0f, -0.25f, -5.5f),
 				0.75f,
 				groundMat,
-				scene.m_SphereCount
+				ro_Scene.m_SphereCount
 			)
 		);
+	}
 
-		const auto& time = std::chrono::steady_clock::now();
-		const int maxBounces = 8	;
-
-		const unsigned int threadCount =
-			std::thread::hardware_concurrency();
+	bool measureRender(IntegratorMode v_Mode, const RenderSettings& ro_Settings, const Scene& ro_Scene,
+					   RenderMeasurement& ro_Result) {
+		const Camera camera = makeCamera(ro_Scene.m_Camera, FP32(ro_Settings.m_Width) / FP32(ro_Settings.m_Height));
 
-		std::vector<std::thread> workers;
+		AccumulationBuffer accumulation;
+		if (!accumulation.initialize(ro_Settings.m_Width, ro_Settings.m_Height)) return false;
 
-		size_t rowsPerThread =
-			kImageHeight / threadCount;
+		const unsigned int threadCount = workerCount(ro_Settings);
+		std::vector<RayCounters> counters(threadCount);
+		std::vector<Memory::FrameArena> arenas(threadCount);
+		if (v_Mode == IntegratorMode::Wavefront) {
+			for (Memory::FrameArena& arena : arenas)
+				if (!arena.reserve(Memory::FRAME_ARENA_RESERVE)) return false;
+		}
 
-		auto startTime = std::chrono::steady_clock::now();
+		uint32_t steals = 0;
+		const auto start = std::chrono::steady_clock::now();
+		renderPass(v_Mode, ro_Settings, ro_Scene, camera, accumulation, 0, ro_Settings.m_SamplesPerPixel,
+				   arenas, counters, steals);
+		ro_Result.m_Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		RayCounters total;
+		for (const RayCounters& c : counters)
+			total += c;
+		ro_Result.m_Rays = total.total();
+		ro_Result.m_Samples = total.m_CameraRays;
+		ro_Result.m_PathLength = total.m_CameraRays
+			? double(total.m_CameraRays + total.m_ExtensionRays) / double(total.m_CameraRays) : 0.0;
+		ro_Result.m_Threads = threadCount;
+		return true;
+	}
 
-		for (unsigned int t = 0; t < threadCount; ++t) {
-			size_t yStart = t * rowsPerThread;
-			size_t yEnd =
-				(t == threadCount - 1)
-				? kImageHeight
-				: yStart + rowsPerThread;
-
-			workers.emplace_back(
-				renderRows,
-				std::cref(scene),
-				framebuffer,
-				yStart,
-				yEnd,
-				kImageWidth,
-				kImageHeight,
-				maxBounces,
-				std::cref(cameraOrigin),
-				std::cref(lowerLeftCorner),
-				std::cref(horizontal),
-				std::cref(vertical)
-			);
+	void basicShadingIntegrator(const RenderSettings& ro_Settings) {
+		Scene scene;
+		if (ro_Settings.m_ScenePath.empty())
+			buildDemoScene(scene);
+		else {
+			const auto loadStart = std::chrono::steady_clock::now();
+			bool fromCache = false;
+			std::string error;
+			if (!loadScene(ro_Settings.m_ScenePath.c_str(), scene, fromCache, error)) {
+				std::cout << "Scene: " << error << "\n";
+				return;
+			}
+			std::cout << "Scene: " << scene.m_MaterialCount << " materials, " << scene.m_SphereCount << " spheres, "
+				<< scene.m_PlaneCount << " planes " << (fromCache ? "mapped from cache" : "parsed") << " in "
+				<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count() << " ms\n";
 		}
 
-		for (auto& w : workers)
-			w.join();
+		const Camera camera = makeCamera(scene.m_Camera, FP32(ro_Settings.m_Width) / FP32(ro_Settings.m_Height));
 
-		auto endTime = std::chrono::steady_clock::now();
-		std::cout << "Time: "
-			<< std::chrono::duration_cast<std::chrono::milliseconds>(
-				endTime - startTime).count()
-			<< " ms\n";
+		finalizeScene(scene);
+
+		const Geometry::BVHBuildStats& bvhStats = scene.m_BVH.m_Stats;
+		std::cout << "BVH: " << bvhStats.m_NodeCount << " nodes, "
+			<< bvhStats.m_LeafCount << " leaves, depth " << bvhStats.m_MaxDepth
+			<< ", SAH cost " << bvhStats.m_SAHCost
+			<< ", built in " << bvhStats.m_BuildMs << " ms on " << bvhStats.m_ThreadCount << " threads\n";
+		const Geometry::BVH8Stats& wideStats = scene.m_WideBVH.m_Stats;
+		std::cout << "BVH8: " << wideStats.m_NodeCount << " nodes, "
+			<< wideStats.m_AverageFill << " children per node, " << wideStats.m_SphereBlockCount << " sphere blocks ("
+			<< wideStats.m_SphereLaneFill * 100.0f << "% lanes used), collapsed in " << wideStats.m_CollapseMs << " ms\n";
+
+		const auto& time = std::chrono::steady_clock::now();
+
+		if (ro_Settings.m_Mode != IntegratorMode::Wavefront)
+			renderImage(IntegratorMode::Megakernel, ro_Settings, scene, camera, "MultithreadedPT");
+		if (ro_Settings.m_Mode != IntegratorMode::Megakernel)
+			renderImage(IntegratorMode::Wavefront, ro_Settings, scene, camera, "WavefrontPT");
 
 		const auto& end = std::chrono::steady_clock::now() - time;
 		std::cout << end << "\n";
-
-		writePPM("MultithreadedPT.ppm", framebuffer, kImageWidth, kImageHeight);
-		delete[] framebuffer;
 	}
 }
\ No newline at end of file
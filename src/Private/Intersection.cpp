@@ -43,4 +43,55 @@ namespace WavefrontPT::Geometry {
 		return HitRecord::captureHit(gn, p, t, ro_Sphere.m_MaterialID, ro_Sphere.m_ObjectID);
 
 	}
-}
\ No newline at end of file
+
+	bool occluded(const Ray& ro_Ray, const GPlane& ro_Plane, FP32 v_TMax) {
+		FP32 d = dot(ro_Plane.m_SurfaceNormal, ro_Ray.m_DirectionCosine);
+		if (absFast(d) < kEpsilon) return false;
+		FP32 t = dot((ro_Plane.m_Center - ro_Ray.m_Origin), ro_Plane.m_SurfaceNormal) / d;
+		if (t < kEpsilon || t >= v_TMax) return false;
+		Vector3 projection = (ro_Ray.m_Origin + scale(ro_Ray.m_DirectionCosine, t)) - ro_Plane.m_Center;
+		return absFast(dot(projection, ro_Plane.m_Tangent)) <= ro_Plane.m_HalfWidth
+			&& absFast(dot(projection, ro_Plane.m_BiTangent)) <= ro_Plane.m_HalfBreadth;
+	}
+
+	bool occluded(const Ray& ro_Ray, const GSphere& ro_Sphere, FP32 v_TMax) {
+		Vector3 l = ro_Ray.m_Origin - ro_Sphere.m_Center;
+		FP32 b = dot(ro_Ray.m_DirectionCosine, l);
+		FP32 c = lengthSq(l) - ro_Sphere.m_Radius * ro_Sphere.m_Radius;
+
+		FP32 det = b * b - c;
+		if (det < 0) return false;
+
+		FP32 root = sqrt(det);
+		FP32 t0 = (-b - root);
+		FP32 t1 = (-b + root);
+
+		// Same root selection as hit(), no point or normal is built
+		FP32 t = t0 > kEpsilon ? t0 : t1;
+		return t > kEpsilon && t < v_TMax;
+	}
+
+	RegFP32 intersectPlanePacket(const RayPacket& ro_Packet, const GPlane& ro_Plane, RegFP32& ro_T) {
+		const Stripe3 normal(_mm256_set1_ps(ro_Plane.m_SurfaceNormal.X), _mm256_set1_ps(ro_Plane.m_SurfaceNormal.Y),
+							 _mm256_set1_ps(ro_Plane.m_SurfaceNormal.Z));
+		const Stripe3 center(_mm256_set1_ps(ro_Plane.m_Center.X), _mm256_set1_ps(ro_Plane.m_Center.Y),
+							 _mm256_set1_ps(ro_Plane.m_Center.Z));
+		const RegFP32 epsilon = _mm256_set1_ps(kEpsilon);
+
+		const RegFP32 d = dot(normal, ro_Packet.m_Direction);
+		const RegFP32 facing = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), d), epsilon, _CMP_GE_OQ);
+		ro_T = _mm256_div_ps(dot(center - ro_Packet.m_Origin, normal), d);
+
+		const Stripe3 projection = (ro_Packet.m_Origin + scale(ro_Packet.m_Direction, ro_T)) - center;
+		const RegFP32 signMask = _mm256_set1_ps(-0.0f);
+		const RegFP32 u = _mm256_andnot_ps(signMask, dot(projection, Stripe3(_mm256_set1_ps(ro_Plane.m_Tangent.X),
+			_mm256_set1_ps(ro_Plane.m_Tangent.Y), _mm256_set1_ps(ro_Plane.m_Tangent.Z))));
+		const RegFP32 v = _mm256_andnot_ps(signMask, dot(projection, Stripe3(_mm256_set1_ps(ro_Plane.m_BiTangent.X),
+			_mm256_set1_ps(ro_Plane.m_BiTangent.Y), _mm256_set1_ps(ro_Plane.m_BiTangent.Z))));
+
+		RegFP32 hit = _mm256_and_ps(facing, _mm256_cmp_ps(ro_T, epsilon, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, _mm256_set1_ps(ro_Plane.m_HalfWidth), _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, _mm256_set1_ps(ro_Plane.m_HalfBreadth), _CMP_LE_OQ));
+		return _mm256_and_ps(hit, ro_Packet.m_Active);
+	}
+}
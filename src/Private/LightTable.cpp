@@ -0,0 +1,69 @@
+#include <Core.h>
+#include <LightTable.h>
+
+#include "IntegratorOps.h"
+
+namespace WavefrontPT::Integrator {
+	LightTable buildLightTable(const Geometry::GSphere* p_Spheres, size_t v_SphereCount, const Materials::Material* p_Materials) {
+		LightTable table;
+		std::vector<Math::FP32> power;
+
+		for (size_t i = 0; i < v_SphereCount; ++i) {
+			const Geometry::GSphere& sphere = p_Spheres[i];
+			const Math::Vector3& emission = p_Materials[sphere.m_MaterialID].m_Emission;
+			const Math::FP32 radiance = Integrators::Ops::luminance(emission);
+			if (!(radiance > 0.0f)) continue;
+
+			table.m_Lights.push_back({ static_cast<Math::ObjectID>(i), emission });
+			power.push_back(radiance * 4.0f * std::numbers::pi_v<float> * sphere.m_Radius * sphere.m_Radius);
+			table.m_TotalPower += power.back();
+		}
+
+		const uint32_t count = static_cast<uint32_t>(table.m_Lights.size());
+		if (!count) return table;
+
+		table.m_Pmf.resize(count);
+		table.m_Alias.resize(count);
+
+		// Vose's method: split scaled probabilities into under- and over-full slots,
+		// then top up each under-full slot from an over-full one
+		std::vector<double> scaled(count);
+		std::vector<uint32_t> small, large;
+		for (uint32_t i = 0; i < count; ++i) {
+			table.m_Pmf[i] = power[i] / table.m_TotalPower;
+			scaled[i] = double(power[i]) * count / double(table.m_TotalPower);
+			(scaled[i] < 1.0 ? small : large).push_back(i);
+		}
+
+		while (!small.empty() && !large.empty()) {
+			const uint32_t s = small.back();
+			small.pop_back();
+			const uint32_t l = large.back();
+
+			table.m_Alias[s] = { Math::FP32(scaled[s]), l };
+			scaled[l] -= 1.0 - scaled[s];
+			if (scaled[l] < 1.0) {
+				large.pop_back();
+				small.push_back(l);
+			}
+		}
+
+		// Leftovers are full up to rounding
+		for (uint32_t i : large) table.m_Alias[i] = { 1.0f, i };
+		for (uint32_t i : small) table.m_Alias[i] = { 1.0f, i };
+
+		return table;
+	}
+
+	uint32_t sampleLight(const LightTable& ro_Table, Math::FP32 v_U, Math::FP32& ro_Pdf) {
+		const uint32_t count = static_cast<uint32_t>(ro_Table.m_Lights.size());
+		const Math::FP32 scaled = v_U * Math::FP32(count);
+		const uint32_t slot = std::min(static_cast<uint32_t>(scaled), count - 1);
+		const Math::FP32 remainder = scaled - Math::FP32(slot);
+
+		const AliasSlot& alias = ro_Table.m_Alias[slot];
+		const uint32_t light = remainder < alias.m_Threshold ? slot : alias.m_Alias;
+		ro_Pdf = ro_Table.m_Pmf[light];
+		return light;
+	}
+}
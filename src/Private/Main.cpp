@@ -1,6 +1,103 @@
+#include <Core.h>
+#include <cstring>
+#include <iostream>
 
 #include "Integrators.h"
+#include "Transcendentals.h"
 
-int main() {
-	WavefrontPT::Integrator::basicShadingIntegrator();
+using namespace WavefrontPT::Integrator;
+
+static bool parseMode(const char* p_Value, IntegratorMode& ro_Mode) {
+	if (!std::strcmp(p_Value, "megakernel")) ro_Mode = IntegratorMode::Megakernel;
+	else if (!std::strcmp(p_Value, "wavefront")) ro_Mode = IntegratorMode::Wavefront;
+	else if (!std::strcmp(p_Value, "both")) ro_Mode = IntegratorMode::Both;
+	else return false;
+	return true;
+}
+
+static bool parseSampler(const char* p_Value, WavefrontPT::Integrators::Ops::SamplerType& ro_Sampler) {
+	using WavefrontPT::Integrators::Ops::SamplerType;
+	if (!std::strcmp(p_Value, "white")) ro_Sampler = SamplerType::WhiteNoise;
+	else if (!std::strcmp(p_Value, "sobol")) ro_Sampler = SamplerType::Sobol;
+	else return false;
+	return true;
+}
+
+static void printUsage() {
+	std::cout << "Usage: WavefrontPT [--mode megakernel|wavefront|both] [--width N] [--height N]"
+		" [--spp N] [--bounces N] [--rr-depth N]\n"
+		"                  [--pass-spp N] [--time-budget-ms N] [--dump-every K]\n"
+		"                  [--adaptive THRESHOLD] [--heatmap 0|1] [--pfm 0|1]\n"
+		"                  [--checkpoint 0|1] [--scene FILE] [--sampler white|sobol]\n"
+		"                  [--sort-rays 0|1] [--threads N]\n"
+		"       WavefrontPT --check-sincos SAMPLES\n";
+}
+
+// Accuracy report of the 8-lane sincos over the sampling domain [0, 2pi)
+static int checkSincos(uint64_t v_Samples) {
+	using namespace WavefrontPT::Math::Transcendentals;
+	const SincosError error = measureSincosError(0.0f, 2.0f * std::numbers::pi_v<float>, v_Samples);
+	auto report = [](const char* p_Name, const SincosErrorBound& ro_Bound) {
+		std::cout << "  " << p_Name << ": sin " << ro_Bound.m_MaxSin << ", cos " << ro_Bound.m_MaxCos
+			<< " max abs error (" << ro_Bound.maxUlps() << " ulp) at " << ro_Bound.m_WorstAngle << "\n";
+	};
+	std::cout << "sincos against double precision, " << error.m_Samples << " angles in [0, 2pi)\n";
+	report("Reg8  ", error.m_Vector);
+	report("scalar", error.m_Scalar);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	RenderSettings settings;
+
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+		if (!value) {
+			printUsage();
+			return 1;
+		}
+
+		if (!std::strcmp(arg, "--check-sincos")) return checkSincos(std::strtoull(value, nullptr, 10));
+
+		if (!std::strcmp(arg, "--mode")) {
+			if (!parseMode(value, settings.m_Mode)) {
+				printUsage();
+				return 1;
+			}
+		}
+		else if (!std::strcmp(arg, "--width")) settings.m_Width = std::strtoull(value, nullptr, 10);
+		else if (!std::strcmp(arg, "--height")) settings.m_Height = std::strtoull(value, nullptr, 10);
+		else if (!std::strcmp(arg, "--spp")) settings.m_SamplesPerPixel = std::atoi(value);
+		else if (!std::strcmp(arg, "--bounces")) settings.m_MaxBounces = std::atoi(value);
+		else if (!std::strcmp(arg, "--rr-depth")) settings.m_RouletteDepth = std::atoi(value);
+		else if (!std::strcmp(arg, "--pass-spp")) settings.m_PassSamples = std::atoi(value);
+		else if (!std::strcmp(arg, "--time-budget-ms")) settings.m_TimeBudgetMs = std::atof(value);
+		else if (!std::strcmp(arg, "--dump-every")) settings.m_DumpEvery = std::atoi(value);
+		else if (!std::strcmp(arg, "--adaptive")) settings.m_AdaptiveThreshold = float(std::atof(value));
+		else if (!std::strcmp(arg, "--heatmap")) settings.m_WriteHeatmap = std::atoi(value) != 0;
+		else if (!std::strcmp(arg, "--pfm")) settings.m_WritePfm = std::atoi(value) != 0;
+		else if (!std::strcmp(arg, "--scene")) settings.m_ScenePath = value;
+		else if (!std::strcmp(arg, "--checkpoint")) settings.m_Checkpoint = std::atoi(value) != 0;
+		else if (!std::strcmp(arg, "--threads")) settings.m_Threads = unsigned(std::max(0, std::atoi(value)));
+		else if (!std::strcmp(arg, "--sort-rays")) settings.m_SortRays = std::atoi(value) != 0;
+		else if (!std::strcmp(arg, "--sampler")) {
+			if (!parseSampler(value, settings.m_Sampler)) {
+				printUsage();
+				return 1;
+			}
+		}
+		else {
+			printUsage();
+			return 1;
+		}
+		++i;
+	}
+
+	if (!settings.m_Width || !settings.m_Height || settings.m_SamplesPerPixel <= 0) {
+		printUsage();
+		return 1;
+	}
+
+	WavefrontPT::Integrator::basicShadingIntegrator(settings);
 }
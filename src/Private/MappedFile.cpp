@@ -0,0 +1,158 @@
+#include <Core.h>
+#include <MappedFile.h>
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace WavefrontPT::Memory {
+	MappedFile::MappedFile(MappedFile&& u_Other) noexcept
+		: m_Data(std::exchange(u_Other.m_Data, nullptr)), m_Size(std::exchange(u_Other.m_Size, 0)),
+#if defined(_WIN32)
+		m_File(std::exchange(u_Other.m_File, nullptr)), m_Mapping(std::exchange(u_Other.m_Mapping, nullptr)) {
+#else
+		m_File(std::exchange(u_Other.m_File, -1)) {
+#endif
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& u_Other) noexcept {
+		if (this != &u_Other) {
+			close();
+			m_Data = std::exchange(u_Other.m_Data, nullptr);
+			m_Size = std::exchange(u_Other.m_Size, 0);
+#if defined(_WIN32)
+			m_File = std::exchange(u_Other.m_File, nullptr);
+			m_Mapping = std::exchange(u_Other.m_Mapping, nullptr);
+#else
+			m_File = std::exchange(u_Other.m_File, -1);
+#endif
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+#if defined(_WIN32)
+	static bool mapView(HANDLE p_File, size_t v_Bytes, bool v_Writable, void*& ro_Mapping, std::byte*& ro_Data) {
+		const ULARGE_INTEGER size{ .QuadPart = v_Bytes };
+		ro_Mapping = CreateFileMappingA(p_File, nullptr, v_Writable ? PAGE_READWRITE : PAGE_READONLY,
+										size.HighPart, size.LowPart, nullptr);
+		if (!ro_Mapping) return false;
+
+		ro_Data = static_cast<std::byte*>(MapViewOfFile(ro_Mapping, v_Writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, v_Bytes));
+		return ro_Data != nullptr;
+	}
+
+	bool MappedFile::create(const char* p_Path, size_t v_Bytes) {
+		close();
+		if (!v_Bytes) return false;
+
+		m_File = CreateFileA(p_Path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_File == INVALID_HANDLE_VALUE) {
+			m_File = nullptr;
+			return false;
+		}
+
+		if (!mapView(m_File, v_Bytes, true, m_Mapping, m_Data)) {
+			close();
+			return false;
+		}
+		m_Size = v_Bytes;
+		return true;
+	}
+
+	bool MappedFile::open(const char* p_Path, bool v_Writable) {
+		close();
+		m_File = CreateFileA(p_Path, v_Writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+							 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_File == INVALID_HANDLE_VALUE) {
+			m_File = nullptr;
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_File, &size) || !size.QuadPart || !mapView(m_File, size_t(size.QuadPart), v_Writable, m_Mapping, m_Data)) {
+			close();
+			return false;
+		}
+		m_Size = size_t(size.QuadPart);
+		return true;
+	}
+
+	bool MappedFile::flush(size_t v_Offset, size_t v_Bytes, bool v_Wait) {
+		if (!m_Data || v_Offset + v_Bytes > m_Size) return false;
+		if (!FlushViewOfFile(m_Data + v_Offset, v_Bytes)) return false;
+		return !v_Wait || FlushFileBuffers(m_File);
+	}
+
+	void MappedFile::close() {
+		if (m_Data) UnmapViewOfFile(m_Data);
+		if (m_Mapping) CloseHandle(m_Mapping);
+		if (m_File) CloseHandle(m_File);
+		m_Data = nullptr;
+		m_Mapping = nullptr;
+		m_File = nullptr;
+		m_Size = 0;
+	}
+#else
+	static std::byte* mapView(int v_File, size_t v_Bytes, bool v_Writable) {
+		const int protection = v_Writable ? PROT_READ | PROT_WRITE : PROT_READ;
+		void* mem = mmap(nullptr, v_Bytes, protection, MAP_SHARED, v_File, 0);
+		return mem == MAP_FAILED ? nullptr : static_cast<std::byte*>(mem);
+	}
+
+	bool MappedFile::create(const char* p_Path, size_t v_Bytes) {
+		close();
+		if (!v_Bytes) return false;
+
+		m_File = ::open(p_Path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (m_File < 0) return false;
+
+		// Sizing up front leaves a sparse file, pages are allocated as the mapping is written
+		if (ftruncate(m_File, off_t(v_Bytes)) != 0 || !(m_Data = mapView(m_File, v_Bytes, true))) {
+			close();
+			return false;
+		}
+		m_Size = v_Bytes;
+		return true;
+	}
+
+	bool MappedFile::open(const char* p_Path, bool v_Writable) {
+		close();
+		m_File = ::open(p_Path, v_Writable ? O_RDWR : O_RDONLY);
+		if (m_File < 0) return false;
+
+		struct stat info;
+		if (fstat(m_File, &info) != 0 || info.st_size <= 0 || !(m_Data = mapView(m_File, size_t(info.st_size), v_Writable))) {
+			close();
+			return false;
+		}
+		m_Size = size_t(info.st_size);
+		return true;
+	}
+
+	bool MappedFile::flush(size_t v_Offset, size_t v_Bytes, bool v_Wait) {
+		if (!m_Data || v_Offset + v_Bytes > m_Size) return false;
+		return msync(m_Data + v_Offset, v_Bytes, v_Wait ? MS_SYNC : MS_ASYNC) == 0;
+	}
+
+	void MappedFile::close() {
+		if (m_Data) munmap(m_Data, m_Size);
+		if (m_File >= 0) ::close(m_File);
+		m_Data = nullptr;
+		m_File = -1;
+		m_Size = 0;
+	}
+#endif
+}
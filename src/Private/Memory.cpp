@@ -1,11 +1,16 @@
 #include <Core.h>
 #include <Memory.h>
 
+#if defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 namespace WavefrontPT::Memory {
+#if defined(_WIN32)
 	void* alloc(void* p_Memory, size_t v_Bytes, MemoryOperation v_Ops) {
 		void* mem = nullptr;
 		switch (v_Ops) {
@@ -26,7 +31,7 @@ namespace WavefrontPT::Memory {
 	bool free(void* p_Memory, size_t v_Bytes, MemoryOperation v_Ops) {
 		if (!p_Memory) return false;
 		switch (v_Ops) {
-		case MemoryOperation::Free: 
+		case MemoryOperation::Free:
 			if (VirtualFree(p_Memory, v_Bytes, MEM_DECOMMIT)) return true;
 			return false;
 		case MemoryOperation::Release:
@@ -37,4 +42,71 @@ namespace WavefrontPT::Memory {
 		}
 		WF_UNREACHABLE();
 	}
-}
\ No newline at end of file
+
+	// Large pages need SeLockMemoryPrivilege and MEM_LARGE_PAGES at reserve time, not supported
+	bool adviseHugePages(void*, size_t) {
+		return false;
+	}
+#else
+	// Reservations of at least one huge page are placed on a huge page boundary so
+	// MADV_HUGEPAGE can back them with whole 2 MiB pages
+	static void* reserveAligned(size_t v_Bytes) {
+		constexpr int kFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+		if (v_Bytes < HUGE_PAGE_SIZE) {
+			void* mem = mmap(nullptr, v_Bytes, PROT_NONE, kFlags, -1, 0);
+			return mem == MAP_FAILED ? nullptr : mem;
+		}
+
+		const size_t padded = v_Bytes + HUGE_PAGE_SIZE;
+		void* mem = mmap(nullptr, padded, PROT_NONE, kFlags, -1, 0);
+		if (mem == MAP_FAILED) return nullptr;
+
+		const uintptr_t base = reinterpret_cast<uintptr_t>(mem);
+		const uintptr_t aligned = (base + HUGE_PAGE_SIZE - 1) & ~uintptr_t(HUGE_PAGE_SIZE - 1);
+		const size_t head = aligned - base;
+		const size_t tail = padded - head - v_Bytes;
+		if (head) munmap(mem, head);
+		if (tail) munmap(reinterpret_cast<void*>(aligned + v_Bytes), tail);
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	void* alloc(void* p_Memory, size_t v_Bytes, MemoryOperation v_Ops) {
+		switch (v_Ops) {
+		case MemoryOperation::Reserve:
+			return reserveAligned(v_Bytes);
+		case MemoryOperation::Commit:
+			if (mprotect(p_Memory, v_Bytes, PROT_READ | PROT_WRITE)) return nullptr;
+			return p_Memory;
+		case MemoryOperation::Release:
+		case MemoryOperation::Free:		return nullptr;
+		}
+		WF_UNREACHABLE();
+	}
+
+	bool free(void* p_Memory, size_t v_Bytes, MemoryOperation v_Ops) {
+		if (!p_Memory) return false;
+		switch (v_Ops) {
+		case MemoryOperation::Free:
+			// Drop the pages first so a later commit sees zero-filled memory, as with MEM_DECOMMIT
+			if (madvise(p_Memory, v_Bytes, MADV_DONTNEED)) return false;
+			return mprotect(p_Memory, v_Bytes, PROT_NONE) == 0;
+		case MemoryOperation::Release:
+			return munmap(p_Memory, v_Bytes) == 0;
+		case MemoryOperation::Commit:
+		case MemoryOperation::Reserve: return false;
+		}
+		WF_UNREACHABLE();
+	}
+
+	bool adviseHugePages(void* p_Memory, size_t v_Bytes) {
+#if defined(MADV_HUGEPAGE)
+		if (!p_Memory) return false;
+		return madvise(p_Memory, v_Bytes, MADV_HUGEPAGE) == 0;
+#else
+		(void)p_Memory;
+		(void)v_Bytes;
+		return false;
+#endif
+	}
+#endif
+}
@@ -0,0 +1,174 @@
+#include <Core.h>
+#include <Microfacet.h>
+
+#include "Transcendentals.h"
+
+namespace WavefrontPT::Materials {
+	using namespace Math;
+
+	// Branchless orthonormal basis around n (Duff et al. 2017)
+	static void buildFrame(const Vector3& ro_N, Vector3& ro_T, Vector3& ro_B) {
+		const FP32 sign = std::copysign(1.0f, ro_N.Z);
+		const FP32 a = -1.0f / (sign + ro_N.Z);
+		const FP32 c = ro_N.X * ro_N.Y * a;
+		ro_T = Vector3(1.0f + sign * ro_N.X * ro_N.X * a, sign * c, -sign * ro_N.X);
+		ro_B = Vector3(c, sign + ro_N.Y * ro_N.Y * a, -ro_N.Y);
+	}
+
+	static FP32 ggxD(FP32 v_CosH, FP32 v_Alpha2) {
+		const FP32 d = v_CosH * v_CosH * (v_Alpha2 - 1.0f) + 1.0f;
+		return v_Alpha2 / (std::numbers::pi_v<float> * d * d);
+	}
+
+	// sqrt(a^2 + (1 - a^2) cos^2), cos * (1 + Lambda) up to a factor of two
+	static FP32 smithTerm(FP32 v_Cos, FP32 v_Alpha2) {
+		return std::sqrt(v_Alpha2 + (1.0f - v_Alpha2) * v_Cos * v_Cos);
+	}
+
+	static Vector3 schlick(const Vector3& ro_F0, FP32 v_Cos) {
+		const FP32 m = 1.0f - std::max(v_Cos, 0.0f);
+		const FP32 m5 = m * m * m * m * m;
+		return ro_F0 + scale(Vector3(1.0f) - ro_F0, m5);
+	}
+
+	Vector3 evaluateGGX(const Vector3& ro_N, const Vector3& ro_Wo, const Vector3& ro_Wi, const Vector3& ro_F0, FP32 v_Alpha) {
+		const FP32 cosO = dot(ro_N, ro_Wo);
+		const FP32 cosI = dot(ro_N, ro_Wi);
+		if (!(cosO > 0.0f && cosI > 0.0f)) return Vector3(0.0f);
+
+		const Vector3 h = normalize(ro_Wo + ro_Wi);
+		const FP32 alpha2 = v_Alpha * v_Alpha;
+		// Height-correlated G2 / (4 cosO cosI)
+		const FP32 visibility = 0.5f / (cosO * smithTerm(cosI, alpha2) + cosI * smithTerm(cosO, alpha2));
+		return scale(schlick(ro_F0, dot(ro_Wo, h)), ggxD(dot(ro_N, h), alpha2) * visibility);
+	}
+
+	Vector3 sampleGGX(const Vector3& ro_N, const Vector3& ro_Wo, const Vector3& ro_F0, FP32 v_Alpha,
+					  FP32 v_U1, FP32 v_U2, Vector3& ro_Wi) {
+		const FP32 cosO = dot(ro_N, ro_Wo);
+		Vector3 t, b;
+		buildFrame(ro_N, t, b);
+
+		// View direction stretched to the hemisphere configuration
+		const Vector3 vh = normalize(Vector3(v_Alpha * dot(ro_Wo, t), v_Alpha * dot(ro_Wo, b), cosO));
+		const FP32 lenSq = vh.X * vh.X + vh.Y * vh.Y;
+		const Vector3 t1 = lenSq > 0.0f ? scale(Vector3(-vh.Y, vh.X, 0.0f), 1.0f / std::sqrt(lenSq)) : Vector3(1.0f, 0.0f, 0.0f);
+		const Vector3 t2 = cross(vh, t1);
+
+		// Disk point warped onto the visible half of the projected hemisphere
+		const FP32 r = std::sqrt(v_U1);
+		const auto [sinPhi, cosPhi] = sinCosFP(2.0f * std::numbers::pi_v<float> * v_U2);
+		const FP32 p1 = r * cosPhi;
+		const FP32 s = 0.5f * (1.0f + vh.Z);
+		const FP32 p2 = (1.0f - s) * std::sqrt(std::max(0.0f, 1.0f - p1 * p1)) + s * r * sinPhi;
+		const Vector3 nh = scale(t1, p1) + scale(t2, p2) + scale(vh, std::sqrt(std::max(0.0f, 1.0f - p1 * p1 - p2 * p2)));
+
+		// Back to the ellipsoid and into world space
+		const Vector3 local = normalize(Vector3(v_Alpha * nh.X, v_Alpha * nh.Y, std::max(0.0f, nh.Z)));
+		const Vector3 h = scale(t, local.X) + scale(b, local.Y) + scale(ro_N, local.Z);
+		ro_Wi = reflect(negate(ro_Wo), h);
+
+		const FP32 cosI = dot(ro_N, ro_Wi);
+		if (!(cosO > 0.0f && cosI > 0.0f)) return Vector3(0.0f);
+
+		// G2 / G1(wo)
+		const FP32 alpha2 = v_Alpha * v_Alpha;
+		const FP32 lambdaO = smithTerm(cosO, alpha2);
+		const FP32 masking = cosI * (cosO + lambdaO) / (cosO * smithTerm(cosI, alpha2) + cosI * lambdaO);
+		return scale(schlick(ro_F0, dot(ro_Wo, h)), masking);
+	}
+
+	//---------------------------------------------------------------
+	// Vectorized Operations
+	//---------------------------------------------------------------
+
+	static void buildFrame(const Stripe3& ro_N, Stripe3& ro_T, Stripe3& ro_B) {
+		const RegFP32 one = _mm256_set1_ps(1.0f);
+		const RegFP32 sign = _mm256_or_ps(one, _mm256_and_ps(ro_N.Z, _mm256_set1_ps(-0.0f)));
+		const RegFP32 a = _mm256_div_ps(_mm256_set1_ps(-1.0f), _mm256_add_ps(sign, ro_N.Z));
+		const RegFP32 c = _mm256_mul_ps(_mm256_mul_ps(ro_N.X, ro_N.Y), a);
+		const RegFP32 signX = _mm256_mul_ps(sign, ro_N.X);
+		ro_T = Stripe3(_mm256_fmadd_ps(_mm256_mul_ps(signX, ro_N.X), a, one), _mm256_mul_ps(sign, c),
+					   _mm256_sub_ps(_mm256_setzero_ps(), signX));
+		ro_B = Stripe3(c, _mm256_fmadd_ps(_mm256_mul_ps(ro_N.Y, ro_N.Y), a, sign),
+					   _mm256_sub_ps(_mm256_setzero_ps(), ro_N.Y));
+	}
+
+	static RegFP32 ggxD(RegFP32 v_CosH, RegFP32 v_Alpha2) {
+		const RegFP32 d = _mm256_fmadd_ps(_mm256_mul_ps(v_CosH, v_CosH), _mm256_sub_ps(v_Alpha2, _mm256_set1_ps(1.0f)),
+										  _mm256_set1_ps(1.0f));
+		return _mm256_div_ps(v_Alpha2, _mm256_mul_ps(_mm256_set1_ps(std::numbers::pi_v<float>), _mm256_mul_ps(d, d)));
+	}
+
+	static RegFP32 smithTerm(RegFP32 v_Cos, RegFP32 v_Alpha2) {
+		const RegFP32 oneMinus = _mm256_sub_ps(_mm256_set1_ps(1.0f), v_Alpha2);
+		return _mm256_sqrt_ps(_mm256_fmadd_ps(oneMinus, _mm256_mul_ps(v_Cos, v_Cos), v_Alpha2));
+	}
+
+	static Stripe3 schlick(const Stripe3& ro_F0, RegFP32 v_Cos) {
+		const RegFP32 one = _mm256_set1_ps(1.0f);
+		const RegFP32 m = _mm256_sub_ps(one, _mm256_max_ps(v_Cos, _mm256_setzero_ps()));
+		const RegFP32 m2 = _mm256_mul_ps(m, m);
+		const RegFP32 m5 = _mm256_mul_ps(_mm256_mul_ps(m2, m2), m);
+		return ro_F0 + scale(Stripe3(one, one, one) - ro_F0, m5);
+	}
+
+	static Stripe3 maskStripe(const Stripe3& ro_Stripe, RegFP32 v_Mask) {
+		return { _mm256_and_ps(ro_Stripe.X, v_Mask), _mm256_and_ps(ro_Stripe.Y, v_Mask), _mm256_and_ps(ro_Stripe.Z, v_Mask) };
+	}
+
+	Stripe3 evaluateGGX(const Stripe3& ro_N, const Stripe3& ro_Wo, const Stripe3& ro_Wi, const Stripe3& ro_F0, RegFP32 v_Alpha) {
+		const RegFP32 zero = _mm256_setzero_ps();
+		const RegFP32 cosO = dot(ro_N, ro_Wo);
+		const RegFP32 cosI = dot(ro_N, ro_Wi);
+		const RegFP32 valid = _mm256_and_ps(_mm256_cmp_ps(cosO, zero, _CMP_GT_OQ), _mm256_cmp_ps(cosI, zero, _CMP_GT_OQ));
+
+		const Stripe3 h = normalize(ro_Wo + ro_Wi);
+		const RegFP32 alpha2 = _mm256_mul_ps(v_Alpha, v_Alpha);
+		const RegFP32 denominator = _mm256_fmadd_ps(cosO, smithTerm(cosI, alpha2), _mm256_mul_ps(cosI, smithTerm(cosO, alpha2)));
+		const RegFP32 visibility = _mm256_div_ps(_mm256_set1_ps(0.5f), denominator);
+		const Stripe3 f = scale(schlick(ro_F0, dot(ro_Wo, h)), _mm256_mul_ps(ggxD(dot(ro_N, h), alpha2), visibility));
+		return maskStripe(f, valid);
+	}
+
+	Stripe3 sampleGGX(const Stripe3& ro_N, const Stripe3& ro_Wo, const Stripe3& ro_F0, RegFP32 v_Alpha,
+					  RegFP32 v_U1, RegFP32 v_U2, Stripe3& ro_Wi) {
+		const RegFP32 zero = _mm256_setzero_ps();
+		const RegFP32 one = _mm256_set1_ps(1.0f);
+		const RegFP32 cosO = dot(ro_N, ro_Wo);
+		Stripe3 t, b;
+		buildFrame(ro_N, t, b);
+
+		const Stripe3 vh = normalize(Stripe3(_mm256_mul_ps(v_Alpha, dot(ro_Wo, t)), _mm256_mul_ps(v_Alpha, dot(ro_Wo, b)), cosO));
+		const RegFP32 lenSq = _mm256_fmadd_ps(vh.X, vh.X, _mm256_mul_ps(vh.Y, vh.Y));
+		const RegFP32 tilted = _mm256_cmp_ps(lenSq, zero, _CMP_GT_OQ);
+		const RegFP32 invLen = _mm256_div_ps(one, _mm256_sqrt_ps(lenSq));
+		const Stripe3 t1(_mm256_blendv_ps(one, _mm256_mul_ps(_mm256_sub_ps(zero, vh.Y), invLen), tilted),
+						 _mm256_and_ps(_mm256_mul_ps(vh.X, invLen), tilted), zero);
+		const Stripe3 t2 = cross(vh, t1);
+
+		RegFP32 sinPhi, cosPhi;
+		Transcendentals::sincos(_mm256_mul_ps(_mm256_set1_ps(2.0f * std::numbers::pi_v<float>), v_U2), sinPhi, cosPhi);
+		const RegFP32 r = _mm256_sqrt_ps(v_U1);
+		const RegFP32 p1 = _mm256_mul_ps(r, cosPhi);
+		const RegFP32 s = _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_add_ps(one, vh.Z));
+		const RegFP32 p1Sq = _mm256_mul_ps(p1, p1);
+		const RegFP32 p2 = _mm256_fmadd_ps(_mm256_sub_ps(one, s), _mm256_sqrt_ps(_mm256_max_ps(zero, _mm256_sub_ps(one, p1Sq))),
+										   _mm256_mul_ps(s, _mm256_mul_ps(r, sinPhi)));
+		const RegFP32 pz = _mm256_sqrt_ps(_mm256_max_ps(zero, _mm256_sub_ps(_mm256_sub_ps(one, p1Sq), _mm256_mul_ps(p2, p2))));
+		const Stripe3 nh = scale(t1, p1) + scale(t2, p2) + scale(vh, pz);
+
+		const Stripe3 local = normalize(Stripe3(_mm256_mul_ps(v_Alpha, nh.X), _mm256_mul_ps(v_Alpha, nh.Y), _mm256_max_ps(zero, nh.Z)));
+		const Stripe3 h = scale(t, local.X) + scale(b, local.Y) + scale(ro_N, local.Z);
+		ro_Wi = reflect(negate(ro_Wo), h);
+
+		const RegFP32 cosI = dot(ro_N, ro_Wi);
+		const RegFP32 valid = _mm256_and_ps(_mm256_cmp_ps(cosO, zero, _CMP_GT_OQ), _mm256_cmp_ps(cosI, zero, _CMP_GT_OQ));
+
+		const RegFP32 alpha2 = _mm256_mul_ps(v_Alpha, v_Alpha);
+		const RegFP32 lambdaO = smithTerm(cosO, alpha2);
+		const RegFP32 denominator = _mm256_fmadd_ps(cosO, smithTerm(cosI, alpha2), _mm256_mul_ps(cosI, lambdaO));
+		const RegFP32 masking = _mm256_div_ps(_mm256_mul_ps(cosI, _mm256_add_ps(cosO, lambdaO)), denominator);
+		return maskStripe(scale(schlick(ro_F0, dot(ro_Wo, h)), masking), valid);
+	}
+}
@@ -4,43 +4,83 @@
 #include <iostream>
 
 #include "IntegratorOps.h"
+#include "Microfacet.h"
+#include "RenderStats.h"
 
 namespace WavefrontPT::Integrator {
-	void evaluateMaterialResponse(const Scene& ro_Scene, Payload& ro_Payload, const Math::HitRecord& ro_Hit, const Materials::Material& ro_Mat) {
-		if (Math::maxFast(ro_Mat.m_Emission.X,
-						  Math::maxFast(ro_Mat.m_Emission.Y, ro_Mat.m_Emission.Z)) > 0.0f) {
-			ro_Payload.m_Radiance = ro_Payload.m_Radiance + ro_Payload.m_Throughput * ro_Mat.m_Emission;
+	using namespace WavefrontPT::Math;
+	using Materials::MaterialClass;
+
+	// ----------------------------------------------------------------------------------
+	// BSDF of one material class. evaluate() returns f(wo, wi), sample() draws wi from
+	// (v_U1, v_U2) and returns the throughput weight f * cos / pdf. Both work in world
+	// space around the geometric normal.
+	// ----------------------------------------------------------------------------------
+	template<MaterialClass Class>
+	struct SurfaceBsdf;
+
+	template<>
+	struct SurfaceBsdf<MaterialClass::Diffuse> {
+		static Math::Vector3 evaluate(const Materials::Material& ro_Mat, const Math::Vector3&, const Math::Vector3&,
+									  const Math::Vector3&) {
+			return Math::scale(ro_Mat.m_Color, std::numbers::inv_pi_v<float>);
+		}
 
-			// Kill the path
-			ro_Payload.m_Throughput = Math::Vector3(0.0f);
-			return;
+		// Cosine-weighted hemisphere, f * cos / pdf reduces to the albedo
+		static Math::Vector3 sample(const Materials::Material& ro_Mat, const Math::Vector3& ro_Normal, const Math::Vector3&,
+									Math::FP32 v_U1, Math::FP32 v_U2, Math::Vector3& ro_Wi) {
+			const Math::Vector3& n = ro_Normal;
+			Math::Vector3 tangent = Math::absFast(n.X) > 0.1f ? Math::Vector3(0, 1, 0) : Math::Vector3(1, 0, 0);
+			tangent = Math::normalize(Math::cross(tangent, n));
+			Math::Vector3 bitangent = cross(n, tangent);
+
+			Math::Vector3 localDir = Integrators::Ops::sampleCosineHemisphere(v_U1, v_U2);
+			Math::Vector3 wi = Math::scale(tangent, localDir.X) + Math::scale(bitangent, localDir.Y) + Math::scale(n, localDir.Z);
+			ro_Wi = normalize(wi);
+			return ro_Mat.m_Color;
+		}
+	};
+
+	// GGX metal, the albedo is the Fresnel reflectance at normal incidence
+	template<>
+	struct SurfaceBsdf<MaterialClass::Metal> {
+		static Math::Vector3 evaluate(const Materials::Material& ro_Mat, const Math::Vector3& ro_Normal, const Math::Vector3& ro_Wo,
+									  const Math::Vector3& ro_Wi) {
+			return Materials::evaluateGGX(ro_Normal, ro_Wo, ro_Wi, ro_Mat.m_Color, Materials::ggxAlpha(ro_Mat.m_Roughness));
 		}
 
-		// NEE
-		const Geometry::GSphere* p_LightSphere = nullptr;
-		Math::Vector3 lightEmission(0.0f);
-
-		for (size_t i = 0; i < ro_Scene.m_SphereCount; ++i) {
-			const auto& sphere = ro_Scene.m_Spheres[i];
-			const auto& mat = ro_Scene.m_Materials[sphere.m_MaterialID];
-
-			if (Math::maxFast(mat.m_Emission.X,
-							  Math::maxFast(mat.m_Emission.Y,
-											mat.m_Emission.Z)) > 0.0f) {
-				p_LightSphere = &sphere;
-				lightEmission = mat.m_Emission;
-				break;
-			}
+		static Math::Vector3 sample(const Materials::Material& ro_Mat, const Math::Vector3& ro_Normal, const Math::Vector3& ro_Wo,
+									Math::FP32 v_U1, Math::FP32 v_U2, Math::Vector3& ro_Wi) {
+			return Materials::sampleGGX(ro_Normal, ro_Wo, ro_Mat.m_Color, Materials::ggxAlpha(ro_Mat.m_Roughness), v_U1, v_U2, ro_Wi);
 		}
+	};
 
-		if (!p_LightSphere)
-			return; // no light in scene
+	void shadeMiss(Payload& ro_Payload) {
+		WF_PROFILE_COUNT(m_TerminatedMiss, 1);
+		ro_Payload.m_Radiance = ro_Payload.m_Radiance + ro_Payload.m_Throughput * Math::Vector3(.1f, .1f, .1f);
+	}
+
+	void shadeEmission(Payload& ro_Payload, const Materials::Material& ro_Mat) {
+		ro_Payload.m_Radiance = ro_Payload.m_Radiance + ro_Payload.m_Throughput * ro_Mat.m_Emission;
+
+		// Kill the path
+		ro_Payload.m_Throughput = Math::Vector3(0.0f);
+		WF_PROFILE_COUNT(m_TerminatedEmission, 1);
+	}
 
-		Math::FP32 u1 = Integrators::Ops::randomFloat(ro_Payload.m_RngState);
-		Math::FP32 u2 = Integrators::Ops::randomFloat(ro_Payload.m_RngState);
+	template<MaterialClass Class>
+	bool sampleDirectLight(const Scene& ro_Scene, Payload& ro_Payload, const Math::HitRecord& ro_Hit,
+						   const Materials::Material& ro_Mat, ShadowRay& ro_Shadow) {
+		Math::FP32 selectionPdf = 0.0f;
+		const uint32_t lightIndex = sampleLight(ro_Scene.m_Lights, Integrators::Ops::sample1D(ro_Payload.m_Sampler), selectionPdf);
+		const LightEntry& light = ro_Scene.m_Lights.m_Lights[lightIndex];
+		const Geometry::GSphere& lightSphere = ro_Scene.m_Spheres[light.m_Sphere];
+
+		Math::FP32 u1, u2;
+		Integrators::Ops::sample2D(ro_Payload.m_Sampler, u1, u2);
 
 		Math::Vector3 sphereDir = Integrators::Ops::sampleUnfiromUnitSphere(u1, u2);
-		Math::Point3 lightPoint = p_LightSphere->m_Center + Math::scale(sphereDir, p_LightSphere->m_Radius);
+		Math::Point3 lightPoint = lightSphere.m_Center + Math::scale(sphereDir, lightSphere.m_Radius);
 		Math::Vector3 lightNorm = sphereDir;
 
 		Math::Vector3 toLight = lightPoint - ro_Hit.m_HitPoint;
@@ -50,38 +90,147 @@ namespace WavefrontPT::Integrator {
 
 		Math::Vector3 wi = Math::scale(toLight, 1.0f / dist);
 
-		Math::Ray shadowRay(ro_Hit.m_HitPoint + Math::scale(ro_Hit.m_GeometricNormal, Math::kEpsilon), wi);
+		Math::FP32 cosSurface = Math::dot(ro_Hit.m_GeometricNormal, wi);
+		Math::FP32 cosLight = Math::dot(lightNorm, Math::negate(wi));
+
+		// Back-facing samples contribute nothing, skip the shadow ray entirely
+		if (!(cosSurface > 0.0f && cosLight > 0.0f)) return false;
+
+		Math::FP32 pdfArea = 1.0f / (4.0f * std::numbers::pi_v<float> *lightSphere.m_Radius * lightSphere.m_Radius);
+		Math::FP32 pdfOmega = selectionPdf * pdfArea * dist2 / cosLight;
+		Math::Vector3 f = SurfaceBsdf<Class>::evaluate(ro_Mat, ro_Hit.m_GeometricNormal,
+													   Math::negate(ro_Payload.m_CurrentRay.m_DirectionCosine), wi);
+		Math::Vector3 Ld = Math::scale(f * light.m_Emission, cosSurface / pdfOmega);
+
+		ro_Shadow.m_Ray = Math::Ray(ro_Hit.m_HitPoint + Math::scale(ro_Hit.m_GeometricNormal, Math::kEpsilon), wi);
+		ro_Shadow.m_TMax = dist - Math::kEpsilon;
+		ro_Shadow.m_Contribution = ro_Payload.m_Throughput * Ld;
+		return true;
+	}
+
+	bool traceShadowRay(const Scene& ro_Scene, const ShadowRay& ro_Shadow) {
+		WF_PROFILE_SCOPE(Shadow);
+		++t_RayCounters.m_ShadowRays;
+		const bool occluded = occludedScene(ro_Scene, ro_Shadow.m_Ray, ro_Shadow.m_TMax);
+		WF_PROFILE_COUNT(m_ShadowOccluded, occluded ? 1 : 0);
+		return !occluded;
+	}
+
+	template<MaterialClass Class>
+	void sampleBounce(Payload& ro_Payload, const Math::HitRecord& ro_Hit, const Materials::Material& ro_Mat) {
+		const Math::Vector3& n = ro_Hit.m_GeometricNormal;
+
+		Math::FP32 u1, u2;
+		Integrators::Ops::sample2D(ro_Payload.m_Sampler, u1, u2);
 
-		Math::HitRecord shadowHit = hitScene(ro_Scene, shadowRay);
+		Math::Vector3 wi;
+		const Math::Vector3 weight = SurfaceBsdf<Class>::sample(ro_Mat, n, Math::negate(ro_Payload.m_CurrentRay.m_DirectionCosine),
+																u1, u2, wi);
+		ro_Payload.m_Throughput = ro_Payload.m_Throughput * weight;
 
-		if (!(shadowHit.m_Hit && shadowHit.m_T < dist - Math::kEpsilon)) {
-			Math::FP32 cosSurface = Math::dot(ro_Hit.m_GeometricNormal, wi);
+		ro_Payload.m_CurrentRay.m_Origin = ro_Hit.m_HitPoint + Math::scale(n, Math::kEpsilon);
+		ro_Payload.m_CurrentRay.m_DirectionCosine = wi;
+	}
+
+	bool surviveRoulette(Payload& ro_Payload) {
+		const Math::Vector3& throughput = ro_Payload.m_Throughput;
+		const Math::FP32 survival = std::min(1.0f, maxFast(throughput.X, maxFast(throughput.Y, throughput.Z)));
+		if (Integrators::Ops::sample1D(ro_Payload.m_Sampler) >= survival) {
+			ro_Payload.m_Throughput = Math::Vector3(0.0f);
+			++t_RayCounters.m_RouletteTerminations;
+			return false;
+		}
+		ro_Payload.m_Throughput = Math::scale(throughput, 1.0f / survival);
+		return true;
+	}
 
-			Math::FP32 cosLight = Math::dot(lightNorm, Math::negate(wi));
+	// 8 lanes of a Stripe3 staged in memory for gathering and scattering
+	struct alignas(32) StripeLanes final {
+		Math::FP32 X[Math::RAY_PACKET_WIDTH] = {};
+		Math::FP32 Y[Math::RAY_PACKET_WIDTH] = {};
+		Math::FP32 Z[Math::RAY_PACKET_WIDTH] = {};
 
-			if (cosSurface > 0.0f && cosLight > 0.0f) {
-				Math::FP32 pdfArea = 1.0f / (4.0f * std::numbers::pi_v<float> *p_LightSphere->m_Radius * p_LightSphere->m_Radius);
-				Math::FP32 pdfOmega = pdfArea * dist2 / cosLight;
-				Math::Vector3 f = Math::scale(ro_Mat.m_Color, std::numbers::inv_pi_v<float>);
-				Math::Vector3 Ld = Math::scale(f * lightEmission, cosSurface / pdfOmega);
-				ro_Payload.m_Radiance = ro_Payload.m_Radiance + ro_Payload.m_Throughput * Ld;
-			}
+		void set(uint32_t v_Lane, const Math::Vector3& ro_Value) {
+			X[v_Lane] = ro_Value.X;
+			Y[v_Lane] = ro_Value.Y;
+			Z[v_Lane] = ro_Value.Z;
 		}
-		Math::Vector3 n = ro_Hit.m_GeometricNormal;
-		Math::Vector3 tangent = Math::absFast(n.X) > 0.1f ? Math::Vector3(0, 1, 0) : Math::Vector3(1, 0, 0);
-		tangent = Math::normalize(Math::cross(tangent, n));
-		Math::Vector3 bitangent = cross(n, tangent);
 
-		u1 = Integrators::Ops::randomFloat(ro_Payload.m_RngState);
-		u2 = Integrators::Ops::randomFloat(ro_Payload.m_RngState);
+		Math::Vector3 get(uint32_t v_Lane) const { return Math::Vector3(X[v_Lane], Y[v_Lane], Z[v_Lane]); }
 
-		Math::Vector3 localDir = Integrators::Ops::sampleCosineHemisphere(u1, u2);
-		wi = Math::scale(tangent, localDir.X) + Math::scale(bitangent, localDir.Y) + Math::scale(n,localDir.Z);
+		Math::Stripe3 load() const { return Math::Stripe3(_mm256_load_ps(X), _mm256_load_ps(Y), _mm256_load_ps(Z)); }
 
-		wi = normalize(wi);
-		ro_Payload.m_Throughput = ro_Payload.m_Throughput * ro_Mat.m_Color;
+		void store(const Math::Stripe3& ro_Stripe) {
+			_mm256_store_ps(X, ro_Stripe.X);
+			_mm256_store_ps(Y, ro_Stripe.Y);
+			_mm256_store_ps(Z, ro_Stripe.Z);
+		}
+	};
+
+	void sampleMetalBounces(Payload* const* pp_Paths, const Math::HitRecord* const* pp_Hits,
+							const Materials::Material* const* pp_Mats, uint32_t v_Count) {
+		// Idle lanes sample from zero vectors and are never scattered back
+		StripeLanes normal, wo, f0;
+		alignas(32) Math::FP32 alpha[Math::RAY_PACKET_WIDTH] = {};
+		alignas(32) Math::FP32 u1[Math::RAY_PACKET_WIDTH] = {};
+		alignas(32) Math::FP32 u2[Math::RAY_PACKET_WIDTH] = {};
+		for (uint32_t lane = 0; lane < v_Count; ++lane) {
+			Integrators::Ops::sample2D(pp_Paths[lane]->m_Sampler, u1[lane], u2[lane]);
+			normal.set(lane, pp_Hits[lane]->m_GeometricNormal);
+			wo.set(lane, Math::negate(pp_Paths[lane]->m_CurrentRay.m_DirectionCosine));
+			f0.set(lane, pp_Mats[lane]->m_Color);
+			alpha[lane] = Materials::ggxAlpha(pp_Mats[lane]->m_Roughness);
+		}
+
+		Math::Stripe3 wi;
+		const Math::Stripe3 weight = Materials::sampleGGX(normal.load(), wo.load(), f0.load(), _mm256_load_ps(alpha),
+														  _mm256_load_ps(u1), _mm256_load_ps(u2), wi);
+		StripeLanes weights, directions;
+		weights.store(weight);
+		directions.store(wi);
+
+		for (uint32_t lane = 0; lane < v_Count; ++lane) {
+			Payload& payload = *pp_Paths[lane];
+			const Math::HitRecord& hit = *pp_Hits[lane];
+			payload.m_Throughput = payload.m_Throughput * weights.get(lane);
+			payload.m_CurrentRay.m_Origin = hit.m_HitPoint + Math::scale(hit.m_GeometricNormal, Math::kEpsilon);
+			payload.m_CurrentRay.m_DirectionCosine = directions.get(lane);
+		}
+	}
 
-		ro_Payload.m_CurrentRay.m_Origin =ro_Hit.m_HitPoint +Math::scale(n, Math::kEpsilon);
-		ro_Payload.m_CurrentRay.m_DirectionCosine =wi;
+	template bool sampleDirectLight<MaterialClass::Diffuse>(const Scene&, Payload&, const Math::HitRecord&,
+															  const Materials::Material&, ShadowRay&);
+	template bool sampleDirectLight<MaterialClass::Metal>(const Scene&, Payload&, const Math::HitRecord&,
+															const Materials::Material&, ShadowRay&);
+	template void sampleBounce<MaterialClass::Diffuse>(Payload&, const Math::HitRecord&, const Materials::Material&);
+	template void sampleBounce<MaterialClass::Metal>(Payload&, const Math::HitRecord&, const Materials::Material&);
+
+	template<MaterialClass Class>
+	static void shadeSurface(const Scene& ro_Scene, Payload& ro_Payload, const Math::HitRecord& ro_Hit, const Materials::Material& ro_Mat) {
+		// NEE
+		if (ro_Scene.m_Lights.isEmpty())
+			return; // no light in scene
+
+		ShadowRay shadow;
+		if (sampleDirectLight<Class>(ro_Scene, ro_Payload, ro_Hit, ro_Mat, shadow)
+			&& traceShadowRay(ro_Scene, shadow))
+			ro_Payload.m_Radiance = ro_Payload.m_Radiance + shadow.m_Contribution;
+
+		sampleBounce<Class>(ro_Payload, ro_Hit, ro_Mat);
+	}
+
+	void evaluateMaterialResponse(const Scene& ro_Scene, Payload& ro_Payload, const Math::HitRecord& ro_Hit, const Materials::Material& ro_Mat) {
+		WF_PROFILE_SCOPE(Shading);
+		switch (Materials::classify(ro_Mat)) {
+		case MaterialClass::Emissive:
+			shadeEmission(ro_Payload, ro_Mat);
+			break;
+		case MaterialClass::Diffuse:
+			shadeSurface<MaterialClass::Diffuse>(ro_Scene, ro_Payload, ro_Hit, ro_Mat);
+			break;
+		case MaterialClass::Metal:
+			shadeSurface<MaterialClass::Metal>(ro_Scene, ro_Payload, ro_Hit, ro_Mat);
+			break;
+		}
 	}
-}
\ No newline at end of file
+}
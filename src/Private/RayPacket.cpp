@@ -0,0 +1,44 @@
+#include <Core.h>
+#include <RayPacket.h>
+
+namespace WavefrontPT::Integrator::Math {
+	Ray laneRay(const RayPacket& ro_Packet, uint32_t v_Lane) {
+		alignas(32) FP32 lanes[6][RAY_PACKET_WIDTH];
+		_mm256_store_ps(lanes[0], ro_Packet.m_Origin.X);
+		_mm256_store_ps(lanes[1], ro_Packet.m_Origin.Y);
+		_mm256_store_ps(lanes[2], ro_Packet.m_Origin.Z);
+		_mm256_store_ps(lanes[3], ro_Packet.m_Direction.X);
+		_mm256_store_ps(lanes[4], ro_Packet.m_Direction.Y);
+		_mm256_store_ps(lanes[5], ro_Packet.m_Direction.Z);
+		return Ray(Point3(lanes[0][v_Lane], lanes[1][v_Lane], lanes[2][v_Lane]),
+				   Vector3(lanes[3][v_Lane], lanes[4][v_Lane], lanes[5][v_Lane]));
+	}
+
+	HitRecord laneHit(const PacketHit& ro_Hit, uint32_t v_Lane) {
+		if (!(ro_Hit.m_HitMask >> v_Lane & 1u)) return HitRecord::captureMiss();
+		return HitRecord::captureHit(
+			Vector3(ro_Hit.m_NormalX[v_Lane], ro_Hit.m_NormalY[v_Lane], ro_Hit.m_NormalZ[v_Lane]),
+			Point3(ro_Hit.m_PointX[v_Lane], ro_Hit.m_PointY[v_Lane], ro_Hit.m_PointZ[v_Lane]),
+			ro_Hit.m_T[v_Lane], ro_Hit.m_MatID[v_Lane], ro_Hit.m_ObjID[v_Lane]);
+	}
+
+	void clearPacketHit(PacketHit& ro_Hit) {
+		for (uint32_t lane = 0; lane < RAY_PACKET_WIDTH; ++lane)
+			setLaneHit(ro_Hit, lane, HitRecord::captureMiss());
+		ro_Hit.m_HitMask = 0;
+	}
+
+	void setLaneHit(PacketHit& ro_Hit, uint32_t v_Lane, const HitRecord& ro_Record) {
+		ro_Hit.m_T[v_Lane] = ro_Record.m_T;
+		ro_Hit.m_NormalX[v_Lane] = ro_Record.m_GeometricNormal.X;
+		ro_Hit.m_NormalY[v_Lane] = ro_Record.m_GeometricNormal.Y;
+		ro_Hit.m_NormalZ[v_Lane] = ro_Record.m_GeometricNormal.Z;
+		ro_Hit.m_PointX[v_Lane] = ro_Record.m_HitPoint.X;
+		ro_Hit.m_PointY[v_Lane] = ro_Record.m_HitPoint.Y;
+		ro_Hit.m_PointZ[v_Lane] = ro_Record.m_HitPoint.Z;
+		ro_Hit.m_MatID[v_Lane] = ro_Record.m_MatID;
+		ro_Hit.m_ObjID[v_Lane] = ro_Record.m_ObjID;
+		if (ro_Record.m_Hit) ro_Hit.m_HitMask |= 1u << v_Lane;
+		else ro_Hit.m_HitMask &= ~(1u << v_Lane);
+	}
+}
@@ -0,0 +1,97 @@
+#include <Core.h>
+#include <RenderStats.h>
+
+#include <cstring>
+#include <fstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace WavefrontPT::Integrator {
+	CacheMissCounter::~CacheMissCounter() {
+#if defined(__linux__)
+		if (m_Fd >= 0) ::close(m_Fd);
+#endif
+	}
+
+	bool CacheMissCounter::open() {
+		if (m_Tried) return isOpen();
+		m_Tried = true;
+#if defined(__linux__)
+		perf_event_attr attr{};
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		m_Fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		return isOpen();
+	}
+
+	uint64_t CacheMissCounter::read() const {
+		uint64_t count = 0;
+#if defined(__linux__)
+		if (m_Fd >= 0 && ::read(m_Fd, &count, sizeof(count)) != ssize_t(sizeof(count))) count = 0;
+#endif
+		return count;
+	}
+
+	struct ProfileEntry final {
+		const char* m_Group;
+		const char* m_Name;
+		uint64_t m_Value;
+	};
+
+	bool writeProfileReport(const std::string& ro_BaseName, const char* p_Mode, const RayCounters& ro_Total, double v_Seconds) {
+		const ProfileCounters& profile = ro_Total.m_Profile;
+		const ProfileEntry entries[] = {
+			{ "rays", "camera", ro_Total.m_CameraRays },
+			{ "rays", "extension", ro_Total.m_ExtensionRays },
+			{ "rays", "shadow", ro_Total.m_ShadowRays },
+			{ "traversal", "nodeTests", profile.m_NodeTests },
+			{ "traversal", "sphereBlockTests", profile.m_SphereBlockTests },
+			{ "traversal", "planeTests", profile.m_PlaneTests },
+			{ "packetTraversal", "nodeTests", profile.m_PacketNodeTests },
+			{ "packetTraversal", "sphereBlockTests", profile.m_PacketSphereBlockTests },
+			{ "packetTraversal", "planeTests", profile.m_PacketPlaneTests },
+			{ "queries", "closestHit", profile.m_ClosestHits },
+			{ "queries", "closestMiss", profile.m_ClosestMisses },
+			{ "queries", "shadowOccluded", profile.m_ShadowOccluded },
+			{ "terminations", "miss", profile.m_TerminatedMiss },
+			{ "terminations", "emission", profile.m_TerminatedEmission },
+			{ "terminations", "throughput", profile.m_TerminatedThroughput },
+			{ "terminations", "roulette", ro_Total.m_RouletteTerminations },
+			{ "terminations", "maxBounce", profile.m_TerminatedMaxBounce },
+			{ "stageCycles", "camera", profile.m_StageCycles[uint32_t(ProfileStage::Camera)] },
+			{ "stageCycles", "extension", profile.m_StageCycles[uint32_t(ProfileStage::Extension)] },
+			{ "stageCycles", "shading", profile.m_StageCycles[uint32_t(ProfileStage::Shading)] },
+			{ "stageCycles", "shadow", profile.m_StageCycles[uint32_t(ProfileStage::Shadow)] },
+			{ "stageCycles", "other", profile.m_StageCycles[uint32_t(ProfileStage::Other)] },
+		};
+
+		std::ofstream json(ro_BaseName + "_profile.json");
+		json << "{\n  \"mode\": \"" << p_Mode << "\",\n  \"seconds\": " << v_Seconds;
+		const char* group = nullptr;
+		for (const ProfileEntry& entry : entries) {
+			if (!group || std::strcmp(group, entry.m_Group)) {
+				json << (group ? "\n  },\n" : ",\n") << "  \"" << entry.m_Group << "\": {\n";
+				group = entry.m_Group;
+			}
+			else
+				json << ",\n";
+			json << "    \"" << entry.m_Name << "\": " << entry.m_Value;
+		}
+		json << "\n  }\n}\n";
+
+		std::ofstream csv(ro_BaseName + "_profile.csv");
+		csv << "group,counter,value\n" << "render,mode," << p_Mode << "\n" << "render,seconds," << v_Seconds << "\n";
+		for (const ProfileEntry& entry : entries)
+			csv << entry.m_Group << "," << entry.m_Name << "," << entry.m_Value << "\n";
+
+		return bool(json) && bool(csv);
+	}
+}
@@ -0,0 +1,209 @@
+#include <Core.h>
+#include <Sampler.h>
+
+namespace WavefrontPT::Integrators::Ops {
+	using namespace Math;
+
+	constexpr uint32_t SOBOL_PIXEL_SALT = 0x85EBCA6Bu;
+	constexpr uint32_t SOBOL_BITS = 32;
+
+	// Primitive polynomial and initial direction numbers of one Sobol dimension
+	struct SobolPolynomial final {
+		uint32_t m_Degree;
+		uint32_t m_Coefficients;
+		uint32_t m_Initial[3];
+	};
+
+	struct SobolMatrices final {
+		uint32_t m_Columns[SOBOL_DIMENSIONS][SOBOL_BITS];
+	};
+
+	// Generator matrix products for every value of each index byte, a point is the xor of
+	// four lookups instead of one branch per index bit. Index and point are both kept
+	// bit-reversed, the space the Owen scramble hashes in, which saves two reversals per draw
+	struct SobolTables final {
+		uint32_t m_Bytes[SOBOL_DIMENSIONS][4][256];
+	};
+
+	// Joe & Kuo (new-joe-kuo-6.21201) dimensions 2-4, dimension 1 is van der Corput
+	constexpr SobolPolynomial SOBOL_POLYNOMIALS[SOBOL_DIMENSIONS - 1] = {
+		{ 1, 0, { 1, 0, 0 } },
+		{ 2, 1, { 1, 3, 0 } },
+		{ 3, 1, { 1, 3, 1 } },
+	};
+
+	static constexpr SobolMatrices buildSobolMatrices() {
+		SobolMatrices matrices{};
+		for (uint32_t bit = 0; bit < SOBOL_BITS; ++bit)
+			matrices.m_Columns[0][bit] = 1u << (SOBOL_BITS - 1 - bit);
+
+		for (uint32_t dim = 1; dim < SOBOL_DIMENSIONS; ++dim) {
+			const SobolPolynomial& poly = SOBOL_POLYNOMIALS[dim - 1];
+			uint32_t* columns = matrices.m_Columns[dim];
+			const uint32_t s = poly.m_Degree;
+			for (uint32_t bit = 0; bit < s; ++bit)
+				columns[bit] = poly.m_Initial[bit] << (SOBOL_BITS - 1 - bit);
+			for (uint32_t bit = s; bit < SOBOL_BITS; ++bit) {
+				columns[bit] = columns[bit - s] ^ (columns[bit - s] >> s);
+				for (uint32_t k = 1; k < s; ++k)
+					if ((poly.m_Coefficients >> (s - 1 - k)) & 1u) columns[bit] ^= columns[bit - k];
+			}
+		}
+		return matrices;
+	}
+
+	static constexpr uint32_t reverseBits(uint32_t v_Value) {
+		v_Value = ((v_Value >> 1) & 0x55555555u) | ((v_Value & 0x55555555u) << 1);
+		v_Value = ((v_Value >> 2) & 0x33333333u) | ((v_Value & 0x33333333u) << 2);
+		v_Value = ((v_Value >> 4) & 0x0F0F0F0Fu) | ((v_Value & 0x0F0F0F0Fu) << 4);
+		v_Value = ((v_Value >> 8) & 0x00FF00FFu) | ((v_Value & 0x00FF00FFu) << 8);
+		return (v_Value >> 16) | (v_Value << 16);
+	}
+
+	static constexpr SobolTables buildSobolTables() {
+		const SobolMatrices matrices = buildSobolMatrices();
+		SobolTables tables{};
+		for (uint32_t dim = 0; dim < SOBOL_DIMENSIONS; ++dim)
+			for (uint32_t byte = 0; byte < 4; ++byte)
+				for (uint32_t value = 0; value < 256; ++value)
+					for (uint32_t bit = 0; bit < 8; ++bit)
+						if ((value >> bit) & 1u)
+							tables.m_Bytes[dim][byte][value] ^= reverseBits(matrices.m_Columns[dim][SOBOL_BITS - 1 - (byte * 8 + bit)]);
+		return tables;
+	}
+
+	alignas(64) constexpr SobolTables SOBOL_TABLES = buildSobolTables();
+
+	// Byte order reversed per lane, then each byte's nibbles swapped and mirrored through a table
+	static __m256i reverseBits(__m256i v_Value) {
+		const __m256i byteSwap = _mm256_setr_epi8(
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+		const __m256i nibbles = _mm256_setr_epi8(
+			0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF,
+			0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+		const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+
+		v_Value = _mm256_shuffle_epi8(v_Value, byteSwap);
+		const __m256i low = _mm256_shuffle_epi8(nibbles, _mm256_and_si256(v_Value, lowNibble));
+		const __m256i high = _mm256_shuffle_epi8(nibbles, _mm256_and_si256(_mm256_srli_epi32(v_Value, 4), lowNibble));
+		return _mm256_or_si256(_mm256_slli_epi32(low, 4), high);
+	}
+
+	// Laine-Karras hash, every output bit depends only on the input bits below it
+	static uint32_t laineKarras(uint32_t v_Value, uint32_t v_Seed) {
+		v_Value += v_Seed;
+		v_Value ^= v_Value * 0x6C50B47Cu;
+		v_Value ^= v_Value * 0xB82F1E52u;
+		v_Value ^= v_Value * 0xC7AFE638u;
+		v_Value ^= v_Value * 0x8D22F6E6u;
+		return v_Value;
+	}
+
+	static __m256i laineKarras(__m256i v_Value, __m256i v_Seed) {
+		v_Value = _mm256_add_epi32(v_Value, v_Seed);
+		v_Value = _mm256_xor_si256(v_Value, _mm256_mullo_epi32(v_Value, _mm256_set1_epi32(int(0x6C50B47Cu))));
+		v_Value = _mm256_xor_si256(v_Value, _mm256_mullo_epi32(v_Value, _mm256_set1_epi32(int(0xB82F1E52u))));
+		v_Value = _mm256_xor_si256(v_Value, _mm256_mullo_epi32(v_Value, _mm256_set1_epi32(int(0xC7AFE638u))));
+		v_Value = _mm256_xor_si256(v_Value, _mm256_mullo_epi32(v_Value, _mm256_set1_epi32(int(0x8D22F6E6u))));
+		return v_Value;
+	}
+
+	// Bit-reversed Sobol point for the bit-reversed index v_Index
+	static uint32_t reversedSobol(uint32_t v_Index, uint32_t v_Dimension) {
+		const auto& bytes = SOBOL_TABLES.m_Bytes[v_Dimension];
+		return bytes[0][v_Index & 0xFF] ^ bytes[1][(v_Index >> 8) & 0xFF]
+			^ bytes[2][(v_Index >> 16) & 0xFF] ^ bytes[3][v_Index >> 24];
+	}
+
+	static __m256i reversedSobol(__m256i v_Index, uint32_t v_Dimension) {
+		const auto& bytes = SOBOL_TABLES.m_Bytes[v_Dimension];
+		const __m256i lowByte = _mm256_set1_epi32(0xFF);
+		__m256i bits = _mm256_i32gather_epi32(reinterpret_cast<const int*>(bytes[0]), _mm256_and_si256(v_Index, lowByte), 4);
+		bits = _mm256_xor_si256(bits, _mm256_i32gather_epi32(reinterpret_cast<const int*>(bytes[1]),
+			_mm256_and_si256(_mm256_srli_epi32(v_Index, 8), lowByte), 4));
+		bits = _mm256_xor_si256(bits, _mm256_i32gather_epi32(reinterpret_cast<const int*>(bytes[2]),
+			_mm256_and_si256(_mm256_srli_epi32(v_Index, 16), lowByte), 4));
+		return _mm256_xor_si256(bits, _mm256_i32gather_epi32(reinterpret_cast<const int*>(bytes[3]),
+			_mm256_srli_epi32(v_Index, 24), 4));
+	}
+
+	// Dimensions are consumed in groups of SOBOL_DIMENSIONS, each group shuffles the
+	// sample index with its own seed so the groups stay decorrelated from one another
+	static uint32_t sobolGroupSeed(uint32_t v_Key, uint32_t v_Dimension) {
+		return hashRandom(v_Key, v_Dimension / SOBOL_DIMENSIONS);
+	}
+
+	// Nested uniform (Owen) scrambles of index and point. Laine-Karras on the reversed bits
+	// flips every bit by a hash of the bits above it. v_Index is the reversed, shuffled index
+	static uint32_t scrambledSobol(uint32_t v_Index, uint32_t v_Seed, uint32_t v_Dimension) {
+		const uint32_t component = v_Dimension % SOBOL_DIMENSIONS;
+		return reverseBits(laineKarras(reversedSobol(v_Index, component), hashRandom(v_Seed, component)));
+	}
+
+	static __m256i scrambledSobol(__m256i v_Index, __m256i v_Seed, uint32_t v_Dimension) {
+		const uint32_t component = v_Dimension % SOBOL_DIMENSIONS;
+		return reverseBits(laineKarras(reversedSobol(v_Index, component), hashRandom(v_Seed, _mm256_set1_epi32(int(component)))));
+	}
+
+	PathSampler makePathSampler(SamplerType v_Type, uint32_t v_Pixel, uint32_t v_Sample, uint32_t v_Dimension) {
+		PathSampler sampler;
+		const bool sobol = v_Type == SamplerType::Sobol;
+		sampler.m_Key = sobol ? mixBits(v_Pixel ^ SOBOL_PIXEL_SALT) : streamKey(v_Pixel, v_Sample);
+		sampler.m_Index = sobol ? reverseBits(v_Sample) : v_Sample;
+		sampler.m_Dimension = v_Dimension;
+		sampler.m_Type = v_Type;
+		return sampler;
+	}
+
+	PathSampler8 makePathSampler8(SamplerType v_Type, __m256i v_Pixel, __m256i v_Sample, uint32_t v_Dimension) {
+		PathSampler8 sampler;
+		const bool sobol = v_Type == SamplerType::Sobol;
+		sampler.m_Key = sobol
+			? mixBits(_mm256_xor_si256(v_Pixel, _mm256_set1_epi32(int(SOBOL_PIXEL_SALT))))
+			: streamKey(v_Pixel, v_Sample);
+		sampler.m_Index = sobol ? reverseBits(v_Sample) : v_Sample;
+		sampler.m_Dimension = v_Dimension;
+		sampler.m_Type = v_Type;
+		return sampler;
+	}
+
+	FP32 sample1D(PathSampler& ro_Sampler) {
+		const uint32_t dim = ro_Sampler.m_Dimension++;
+		if (ro_Sampler.m_Type == SamplerType::WhiteNoise)
+			return toUnitFloat(hashRandom(ro_Sampler.m_Key, dim));
+
+		const uint32_t seed = sobolGroupSeed(ro_Sampler.m_Key, dim);
+		return toUnitFloat(scrambledSobol(laineKarras(ro_Sampler.m_Index, seed), seed, dim));
+	}
+
+	void sample2D(PathSampler& ro_Sampler, FP32& ro_U1, FP32& ro_U2) {
+		const uint32_t dim = (ro_Sampler.m_Dimension + 1) & ~1u;
+		ro_Sampler.m_Dimension = dim + 2;
+		if (ro_Sampler.m_Type == SamplerType::WhiteNoise) {
+			ro_U1 = toUnitFloat(hashRandom(ro_Sampler.m_Key, dim));
+			ro_U2 = toUnitFloat(hashRandom(ro_Sampler.m_Key, dim + 1));
+			return;
+		}
+
+		const uint32_t seed = sobolGroupSeed(ro_Sampler.m_Key, dim);
+		const uint32_t index = laineKarras(ro_Sampler.m_Index, seed);
+		ro_U1 = toUnitFloat(scrambledSobol(index, seed, dim));
+		ro_U2 = toUnitFloat(scrambledSobol(index, seed, dim + 1));
+	}
+
+	void sample2D(PathSampler8& ro_Sampler, Reg8& ro_U1, Reg8& ro_U2) {
+		const uint32_t dim = (ro_Sampler.m_Dimension + 1) & ~1u;
+		ro_Sampler.m_Dimension = dim + 2;
+		if (ro_Sampler.m_Type == SamplerType::WhiteNoise) {
+			ro_U1 = toUnitFloat(hashRandom(ro_Sampler.m_Key, _mm256_set1_epi32(int(dim))));
+			ro_U2 = toUnitFloat(hashRandom(ro_Sampler.m_Key, _mm256_set1_epi32(int(dim + 1))));
+			return;
+		}
+
+		const __m256i seed = hashRandom(ro_Sampler.m_Key, _mm256_set1_epi32(int(dim / SOBOL_DIMENSIONS)));
+		const __m256i index = laineKarras(ro_Sampler.m_Index, seed);
+		ro_U1 = toUnitFloat(scrambledSobol(index, seed, dim));
+		ro_U2 = toUnitFloat(scrambledSobol(index, seed, dim + 1));
+	}
+}
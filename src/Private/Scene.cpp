@@ -1,28 +1,66 @@
 #include <Core.h>
 #include <Scene.h>
 
+#include <bit>
+
 #include "Intersection.h"
+#include "RenderStats.h"
 
 namespace WavefrontPT::Integrator {
+	// Next free slot of a scene array, growing its arena by a chunk when the committed pages run out
+	template<typename T>
+	static T* appendSlot(Memory::ArenaWalker<T>& ro_Arena, size_t v_MaxCount, uint32_t v_Count) {
+		if (!ro_Arena.data()) {
+			if (!ro_Arena.reserve(v_MaxCount * sizeof(T))) return nullptr;
+		}
+		if (ro_Arena.committedCount() <= v_Count) {
+			const size_t remaining = ro_Arena.reservedCount() - ro_Arena.committedCount();
+			if (!remaining || !ro_Arena.commitForward(std::min(SCENE_COMMIT_CHUNK, remaining))) return nullptr;
+		}
+		return ro_Arena.data() + v_Count;
+	}
+
 	Math::ObjectID addPlane(Scene& ro_Scene, const Geometry::GPlane& ro_Plane) {
-		if (ro_Scene.m_PlaneCount == MAX_COUNT) return Math::INVALID_OBJ_ID;
-		ro_Scene.m_Planes[ro_Scene.m_PlaneCount++] = ro_Plane;
-		return ro_Scene.m_PlaneCount -1;
+		if (ro_Scene.m_Cache.isOpen()) return Math::INVALID_OBJ_ID;
+		Geometry::GPlane* slot = appendSlot(ro_Scene.m_PlaneArena, SCENE_MAX_PLANES, ro_Scene.m_PlaneCount);
+		if (!slot) return Math::INVALID_OBJ_ID;
+		*slot = ro_Plane;
+		ro_Scene.m_Planes = ro_Scene.m_PlaneArena.data();
+		return ro_Scene.m_PlaneCount++;
 	}
 
 	Math::ObjectID addSphere(Scene& ro_Scene, const Geometry::GSphere& ro_Sphere) {
-		if (ro_Scene.m_SphereCount == MAX_COUNT) return Math::INVALID_OBJ_ID;
-		ro_Scene.m_Spheres[ro_Scene.m_SphereCount++] = ro_Sphere;
-		return ro_Scene.m_SphereCount -1;
+		if (ro_Scene.m_Cache.isOpen()) return Math::INVALID_OBJ_ID;
+		Geometry::GSphere* slot = appendSlot(ro_Scene.m_SphereArena, SCENE_MAX_SPHERES, ro_Scene.m_SphereCount);
+		if (!slot) return Math::INVALID_OBJ_ID;
+		*slot = ro_Sphere;
+		ro_Scene.m_Spheres = ro_Scene.m_SphereArena.data();
+		return ro_Scene.m_SphereCount++;
 	}
 
 	Math::MaterialID registerMaterial(Scene& ro_Scene, const Materials::Material& ro_Mat) {
-		if (ro_Scene.m_MaterialCount == MAX_COUNT) return Math::INVALID_MAT_ID;
-		ro_Scene.m_Materials[ro_Scene.m_MaterialCount++] = ro_Mat;
-		return ro_Scene.m_MaterialCount -1;
+		if (ro_Scene.m_Cache.isOpen()) return Math::INVALID_MAT_ID;
+		Materials::Material* slot = appendSlot(ro_Scene.m_MaterialArena, SCENE_MAX_MATERIALS, ro_Scene.m_MaterialCount);
+		if (!slot) return Math::INVALID_MAT_ID;
+		*slot = ro_Mat;
+		ro_Scene.m_Materials = ro_Scene.m_MaterialArena.data();
+		return ro_Scene.m_MaterialCount++;
 	}
 
-	Math::HitRecord hitScene(const Scene& ro_Scene, const Math::Ray& ro_Ray) {
+	void finalizeScene(Scene& ro_Scene) {
+		ro_Scene.m_BVH = Geometry::buildBVH(ro_Scene.m_Spheres, ro_Scene.m_SphereCount,
+											ro_Scene.m_Planes, ro_Scene.m_PlaneCount);
+		ro_Scene.m_WideBVH = Geometry::collapseBVH(ro_Scene.m_BVH, ro_Scene.m_Spheres);
+		ro_Scene.m_Lights = buildLightTable(ro_Scene.m_Spheres, ro_Scene.m_SphereCount, ro_Scene.m_Materials);
+	}
+
+	static Math::HitRecord closestHit(const Scene& ro_Scene, const Math::Ray& ro_Ray) {
+		if (!ro_Scene.m_WideBVH.isEmpty())
+			return Geometry::intersect(ro_Scene.m_WideBVH, ro_Scene.m_Spheres, ro_Scene.m_Planes, ro_Ray);
+		if (!ro_Scene.m_BVH.isEmpty())
+			return Geometry::intersect(ro_Scene.m_BVH, ro_Scene.m_Spheres, ro_Scene.m_Planes, ro_Ray);
+
+		// Not finalized, fall back to the linear scan
 		Math::HitRecord closest = Math::HitRecord::captureMiss();
 		Math::FP32 tMin = std::numeric_limits<Math::FP32>::infinity();
 
@@ -47,4 +85,41 @@ namespace WavefrontPT::Integrator {
 		return closest;
 	}
 
+	Math::HitRecord hitScene(const Scene& ro_Scene, const Math::Ray& ro_Ray) {
+		WF_PROFILE_SCOPE(Extension);
+		const Math::HitRecord closest = closestHit(ro_Scene, ro_Ray);
+		WF_PROFILE_COUNT(m_ClosestHits, closest.m_Hit ? 1 : 0);
+		WF_PROFILE_COUNT(m_ClosestMisses, closest.m_Hit ? 0 : 1);
+		return closest;
+	}
+
+	void hitScene(const Scene& ro_Scene, const Math::RayPacket& ro_Packet, Math::PacketHit& ro_Hit) {
+		if (!ro_Scene.m_WideBVH.isEmpty()) {
+			Geometry::intersect(ro_Scene.m_WideBVH, ro_Scene.m_Spheres, ro_Scene.m_Planes, ro_Packet, ro_Hit);
+			WF_PROFILE_COUNT(m_ClosestHits, uint64_t(std::popcount(ro_Hit.m_HitMask)));
+			WF_PROFILE_COUNT(m_ClosestMisses, uint64_t(std::popcount(ro_Packet.activeMask() & ~ro_Hit.m_HitMask)));
+			return;
+		}
+
+		// No wide BVH to walk the packet through, trace its lanes one by one
+		Math::clearPacketHit(ro_Hit);
+		for (uint32_t active = ro_Packet.activeMask(); active; active &= active - 1) {
+			const uint32_t lane = static_cast<uint32_t>(std::countr_zero(active));
+			Math::setLaneHit(ro_Hit, lane, hitScene(ro_Scene, Math::laneRay(ro_Packet, lane)));
+		}
+	}
+
+	bool occludedScene(const Scene& ro_Scene, const Math::Ray& ro_Ray, Math::FP32 v_TMax) {
+		if (!ro_Scene.m_WideBVH.isEmpty())
+			return Geometry::occluded(ro_Scene.m_WideBVH, ro_Scene.m_Spheres, ro_Scene.m_Planes, ro_Ray, v_TMax);
+		if (!ro_Scene.m_BVH.isEmpty())
+			return Geometry::occluded(ro_Scene.m_BVH, ro_Scene.m_Spheres, ro_Scene.m_Planes, ro_Ray, v_TMax);
+
+		for (Math::ObjectID i = 0; i < ro_Scene.m_SphereCount; ++i)
+			if (Geometry::occluded(ro_Ray, ro_Scene.m_Spheres[i], v_TMax)) return true;
+		for (Math::ObjectID i = 0; i < ro_Scene.m_PlaneCount; ++i)
+			if (Geometry::occluded(ro_Ray, ro_Scene.m_Planes[i], v_TMax)) return true;
+		return false;
+	}
+
 }
@@ -0,0 +1,224 @@
+#include <Core.h>
+#include <SceneLoader.h>
+
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+namespace WavefrontPT::Integrator {
+	static bool isBlank(char v_Char) {
+		return v_Char == ' ' || v_Char == '\t' || v_Char == '\r';
+	}
+
+	// Next whitespace separated token before p_LineEnd, empty at the end of the line or at a comment
+	static std::string_view nextToken(const char*& ro_Cursor, const char* p_LineEnd) {
+		while (ro_Cursor < p_LineEnd && isBlank(*ro_Cursor)) ++ro_Cursor;
+		if (ro_Cursor == p_LineEnd || *ro_Cursor == '#') return {};
+
+		const char* begin = ro_Cursor;
+		while (ro_Cursor < p_LineEnd && !isBlank(*ro_Cursor) && *ro_Cursor != '#') ++ro_Cursor;
+		return { begin, size_t(ro_Cursor - begin) };
+	}
+
+	static bool readFloats(const char*& ro_Cursor, const char* p_LineEnd, Math::FP32* p_Out, size_t v_Count) {
+		for (size_t i = 0; i < v_Count; ++i) {
+			const std::string_view token = nextToken(ro_Cursor, p_LineEnd);
+			const char* end = token.data() + token.size();
+			if (token.empty() || std::from_chars(token.data(), end, p_Out[i]).ptr != end) return false;
+		}
+		return true;
+	}
+
+	bool parseScene(const char* p_Text, size_t v_Bytes, const char* p_Name, Scene& ro_Scene, std::string& ro_Error) {
+		std::unordered_map<std::string_view, Math::MaterialID> materials;
+		const char* cursor = p_Text;
+		const char* textEnd = p_Text + v_Bytes;
+		uint32_t line = 0;
+
+		auto fail = [&](const std::string& ro_What) {
+			ro_Error = std::string(p_Name) + ":" + std::to_string(line) + ": " + ro_What;
+			return false;
+		};
+
+		while (cursor < textEnd) {
+			++line;
+			const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', size_t(textEnd - cursor)));
+			if (!lineEnd) lineEnd = textEnd;
+			const char* c = cursor;
+			cursor = lineEnd < textEnd ? lineEnd + 1 : textEnd;
+
+			const std::string_view keyword = nextToken(c, lineEnd);
+			if (keyword.empty()) continue;
+
+			Math::FP32 v[14];
+			if (keyword == "material") {
+				const std::string_view name = nextToken(c, lineEnd);
+				if (name.empty() || !readFloats(c, lineEnd, v, 8)) return fail("expected material <name> <r g b> <emission r g b> <metalness> <roughness>");
+				if (materials.contains(name)) return fail("material '" + std::string(name) + "' is defined twice");
+
+				const Math::MaterialID id = registerMaterial(ro_Scene,
+					Materials::Material(Math::Vector3(v[0], v[1], v[2]), Math::Vector3(v[3], v[4], v[5]), v[6], v[7]));
+				if (id == Math::INVALID_MAT_ID) return fail("too many materials");
+				materials.emplace(name, id);
+			}
+			else if (keyword == "sphere" || keyword == "plane") {
+				const bool sphere = keyword == "sphere";
+				if (!readFloats(c, lineEnd, v, sphere ? 4 : 14))
+					return fail(sphere ? "expected sphere <center x y z> <radius> <material>"
+								: "expected plane <center> <normal> <tangent> <bitangent> <half width> <half breadth> <material>");
+
+				const std::string_view name = nextToken(c, lineEnd);
+				const auto material = materials.find(name);
+				if (material == materials.end()) return fail("unknown material '" + std::string(name) + "'");
+
+				const Math::ObjectID id = sphere
+					? addSphere(ro_Scene, Geometry::GSphere(Math::Point3(v[0], v[1], v[2]), v[3], material->second, ro_Scene.m_SphereCount))
+					: addPlane(ro_Scene, Geometry::GPlane(Math::Point3(v[0], v[1], v[2]), Math::Vector3(v[3], v[4], v[5]),
+														  Math::Vector3(v[6], v[7], v[8]), Math::Vector3(v[9], v[10], v[11]),
+														  v[12], v[13], material->second, ro_Scene.m_PlaneCount));
+				if (id == Math::INVALID_OBJ_ID) return fail(sphere ? "too many spheres" : "too many planes");
+			}
+			else if (keyword == "camera") {
+				if (!readFloats(c, lineEnd, v, 10)) return fail("expected camera <origin x y z> <look-at x y z> <up x y z> <vertical fov>");
+				ro_Scene.m_Camera.m_Origin = Math::Point3(v[0], v[1], v[2]);
+				ro_Scene.m_Camera.m_LookAt = Math::Point3(v[3], v[4], v[5]);
+				ro_Scene.m_Camera.m_Up = Math::Vector3(v[6], v[7], v[8]);
+				ro_Scene.m_Camera.m_VerticalFov = v[9];
+			}
+			else return fail("unknown keyword '" + std::string(keyword) + "'");
+
+			if (!nextToken(c, lineEnd).empty()) return fail("unexpected trailing input");
+		}
+
+		return true;
+	}
+
+	static constexpr uint64_t alignCache(uint64_t v_Offset) {
+		return (v_Offset + SCENE_CACHE_ALIGNMENT - 1) & ~uint64_t(SCENE_CACHE_ALIGNMENT - 1);
+	}
+
+	// Points ro_Scene's arrays into p_Path when it is a current cache, ro_Scene takes over the mapping
+	static bool mapSceneCache(const char* p_Path, uint64_t v_SourceBytes, int64_t v_SourceTime, Scene& ro_Scene) {
+		Memory::MappedFile cache;
+		if (!cache.open(p_Path) || cache.size() < sizeof(SceneCacheHeader)) return false;
+
+		const SceneCacheHeader& header = *reinterpret_cast<const SceneCacheHeader*>(cache.data());
+		if (header.m_Magic != SCENE_CACHE_MAGIC || header.m_Version != SCENE_CACHE_VERSION
+			|| header.m_SourceBytes != v_SourceBytes || header.m_SourceTime != v_SourceTime
+			|| header.m_MaterialBytes != sizeof(Materials::Material) || header.m_SphereBytes != sizeof(Geometry::GSphere)
+			|| header.m_PlaneBytes != sizeof(Geometry::GPlane))
+			return false;
+
+		auto fits = [&](uint64_t v_Offset, uint64_t v_Count, uint64_t v_Stride) {
+			return v_Offset % SCENE_CACHE_ALIGNMENT == 0 && v_Offset + v_Count * v_Stride <= cache.size();
+		};
+		if (!fits(header.m_MaterialOffset, header.m_MaterialCount, sizeof(Materials::Material))
+			|| !fits(header.m_SphereOffset, header.m_SphereCount, sizeof(Geometry::GSphere))
+			|| !fits(header.m_PlaneOffset, header.m_PlaneCount, sizeof(Geometry::GPlane)))
+			return false;
+
+		ro_Scene.m_Materials = reinterpret_cast<Materials::Material*>(cache.data() + header.m_MaterialOffset);
+		ro_Scene.m_Spheres = reinterpret_cast<Geometry::GSphere*>(cache.data() + header.m_SphereOffset);
+		ro_Scene.m_Planes = reinterpret_cast<Geometry::GPlane*>(cache.data() + header.m_PlaneOffset);
+		ro_Scene.m_MaterialCount = header.m_MaterialCount;
+		ro_Scene.m_SphereCount = header.m_SphereCount;
+		ro_Scene.m_PlaneCount = header.m_PlaneCount;
+		ro_Scene.m_Camera = header.m_Camera;
+		ro_Scene.m_Cache = std::move(cache);
+		return true;
+	}
+
+	bool writeSceneCache(const char* p_Path, const Scene& ro_Scene, uint64_t v_SourceBytes, int64_t v_SourceTime) {
+		const uint64_t materialOffset = alignCache(sizeof(SceneCacheHeader));
+		const uint64_t sphereOffset = alignCache(materialOffset + uint64_t(ro_Scene.m_MaterialCount) * sizeof(Materials::Material));
+		const uint64_t planeOffset = alignCache(sphereOffset + uint64_t(ro_Scene.m_SphereCount) * sizeof(Geometry::GSphere));
+		const uint64_t fileBytes = planeOffset + uint64_t(ro_Scene.m_PlaneCount) * sizeof(Geometry::GPlane);
+
+		// Written next to the cache and renamed over it, so a concurrent run never maps a half-written file
+		const std::string staging = std::string(p_Path) + ".tmp";
+		{
+			Memory::MappedFile file;
+			if (!file.create(staging.c_str(), size_t(fileBytes))) return false;
+
+			std::byte* base = file.data();
+			if (ro_Scene.m_MaterialCount) std::memcpy(base + materialOffset, ro_Scene.m_Materials, ro_Scene.m_MaterialCount * sizeof(Materials::Material));
+			if (ro_Scene.m_SphereCount) std::memcpy(base + sphereOffset, ro_Scene.m_Spheres, ro_Scene.m_SphereCount * sizeof(Geometry::GSphere));
+			if (ro_Scene.m_PlaneCount) std::memcpy(base + planeOffset, ro_Scene.m_Planes, ro_Scene.m_PlaneCount * sizeof(Geometry::GPlane));
+
+			SceneCacheHeader& header = *reinterpret_cast<SceneCacheHeader*>(base);
+			header.m_Version = SCENE_CACHE_VERSION;
+			header.m_SourceBytes = v_SourceBytes;
+			header.m_SourceTime = v_SourceTime;
+			header.m_MaterialBytes = sizeof(Materials::Material);
+			header.m_SphereBytes = sizeof(Geometry::GSphere);
+			header.m_PlaneBytes = sizeof(Geometry::GPlane);
+			header.m_MaterialCount = ro_Scene.m_MaterialCount;
+			header.m_SphereCount = ro_Scene.m_SphereCount;
+			header.m_PlaneCount = ro_Scene.m_PlaneCount;
+			header.m_MaterialOffset = materialOffset;
+			header.m_SphereOffset = sphereOffset;
+			header.m_PlaneOffset = planeOffset;
+			header.m_Camera = ro_Scene.m_Camera;
+			header.m_Magic = SCENE_CACHE_MAGIC;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(staging, p_Path, error);
+		return !error;
+	}
+
+	bool sceneIdentity(const std::string& ro_Path, SceneIdentity& ro_Identity) {
+		ro_Identity = SceneIdentity{};
+		if (ro_Path.empty()) return true;
+
+		std::error_code error;
+		const std::string canonical = std::filesystem::weakly_canonical(ro_Path, error).string();
+		const std::string& hashed = error ? ro_Path : canonical;
+
+		// FNV-1a
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (char c : hashed)
+			hash = (hash ^ uint8_t(c)) * 0x100000001B3ull;
+		ro_Identity.m_PathHash = hash;
+
+		error.clear();
+		ro_Identity.m_SourceBytes = std::filesystem::file_size(ro_Path, error);
+		if (error) {
+			ro_Identity.m_SourceBytes = 0;
+			return false;
+		}
+		ro_Identity.m_SourceTime = int64_t(std::filesystem::last_write_time(ro_Path, error).time_since_epoch().count());
+		return !error;
+	}
+
+	bool loadScene(const char* p_Path, Scene& ro_Scene, bool& ro_FromCache, std::string& ro_Error) {
+		ro_FromCache = false;
+
+		std::error_code error;
+		const uint64_t sourceBytes = std::filesystem::file_size(p_Path, error);
+		if (error) {
+			ro_Error = std::string(p_Path) + ": " + error.message();
+			return false;
+		}
+		const int64_t sourceTime = int64_t(std::filesystem::last_write_time(p_Path, error).time_since_epoch().count());
+
+		const std::string cachePath = std::string(p_Path) + ".bin";
+		if (!error && mapSceneCache(cachePath.c_str(), sourceBytes, sourceTime, ro_Scene)) {
+			ro_FromCache = true;
+			return true;
+		}
+
+		Memory::MappedFile source;
+		if (!source.open(p_Path)) {
+			ro_Error = std::string(p_Path) + ": cannot map an empty or unreadable file";
+			return false;
+		}
+		if (!parseScene(reinterpret_cast<const char*>(source.data()), source.size(), p_Path, ro_Scene, ro_Error)) return false;
+
+		// A cache that cannot be written only costs the next run a parse
+		if (!error) writeSceneCache(cachePath.c_str(), ro_Scene, sourceBytes, sourceTime);
+		return true;
+	}
+}
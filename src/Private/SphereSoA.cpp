@@ -0,0 +1,118 @@
+#include <Core.h>
+#include <SphereSoA.h>
+
+#include <bit>
+
+namespace WavefrontPT::Geometry {
+	using namespace Integrator::Math;
+
+	void clearSphereBlock(SphereBlock& ro_Block) {
+		for (uint32_t lane = 0; lane < SPHERE_BLOCK_WIDTH; ++lane) {
+			ro_Block.m_CenterX[lane] = ro_Block.m_CenterY[lane] = ro_Block.m_CenterZ[lane] = 0.0f;
+			ro_Block.m_RadiusSq[lane] = -INFINITY;
+			ro_Block.m_MaterialID[lane] = INVALID_MAT_ID;
+			ro_Block.m_Index[lane] = INVALID_OBJ_ID;
+		}
+	}
+
+	void setSphereLane(SphereBlock& ro_Block, uint32_t v_Lane, const GSphere& ro_Sphere, ObjectID v_Index) {
+		ro_Block.m_CenterX[v_Lane] = ro_Sphere.m_Center.X;
+		ro_Block.m_CenterY[v_Lane] = ro_Sphere.m_Center.Y;
+		ro_Block.m_CenterZ[v_Lane] = ro_Sphere.m_Center.Z;
+		ro_Block.m_RadiusSq[v_Lane] = ro_Sphere.m_Radius * ro_Sphere.m_Radius;
+		ro_Block.m_MaterialID[v_Lane] = ro_Sphere.m_MaterialID;
+		ro_Block.m_Index[v_Lane] = v_Index;
+	}
+
+	// Per-lane root t, ro_Hit flags the lanes that hit in [kEpsilon, v_TMax] (v_Inclusive) or [kEpsilon, v_TMax)
+	static RegFP32 sphereRoots(const SphereBlock& ro_Block, const Ray& ro_Ray, FP32 v_TMax, bool v_Inclusive, RegFP32& ro_Hit) {
+		const RegFP32 lx = _mm256_sub_ps(_mm256_set1_ps(ro_Ray.m_Origin.X), _mm256_load_ps(ro_Block.m_CenterX));
+		const RegFP32 ly = _mm256_sub_ps(_mm256_set1_ps(ro_Ray.m_Origin.Y), _mm256_load_ps(ro_Block.m_CenterY));
+		const RegFP32 lz = _mm256_sub_ps(_mm256_set1_ps(ro_Ray.m_Origin.Z), _mm256_load_ps(ro_Block.m_CenterZ));
+
+		const RegFP32 b = _mm256_fmadd_ps(_mm256_set1_ps(ro_Ray.m_DirectionCosine.Z), lz,
+			_mm256_fmadd_ps(_mm256_set1_ps(ro_Ray.m_DirectionCosine.Y), ly,
+				_mm256_mul_ps(_mm256_set1_ps(ro_Ray.m_DirectionCosine.X), lx)));
+		const RegFP32 c = _mm256_sub_ps(_mm256_fmadd_ps(lz, lz, _mm256_fmadd_ps(ly, ly, _mm256_mul_ps(lx, lx))),
+										_mm256_load_ps(ro_Block.m_RadiusSq));
+		const RegFP32 det = _mm256_fmsub_ps(b, b, c);
+
+		const RegFP32 root = _mm256_sqrt_ps(_mm256_max_ps(det, _mm256_setzero_ps()));
+		const RegFP32 negB = _mm256_sub_ps(_mm256_setzero_ps(), b);
+		const RegFP32 t0 = _mm256_sub_ps(negB, root);
+		const RegFP32 t1 = _mm256_add_ps(negB, root);
+
+		// Near root unless it lies behind the origin, as in the scalar hit()
+		const RegFP32 epsilon = _mm256_set1_ps(kEpsilon);
+		const RegFP32 t = _mm256_blendv_ps(t1, t0, _mm256_cmp_ps(t0, epsilon, _CMP_GT_OQ));
+
+		const RegFP32 tMax = _mm256_set1_ps(v_TMax);
+		ro_Hit = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(t, epsilon, _CMP_GT_OQ)),
+			v_Inclusive ? _mm256_cmp_ps(t, tMax, _CMP_LE_OQ) : _mm256_cmp_ps(t, tMax, _CMP_LT_OQ));
+		return t;
+	}
+
+	bool intersectSphereBlock(const SphereBlock& ro_Block, const Ray& ro_Ray, FP32 v_TMax, FP32& ro_T, uint32_t& ro_Lane) {
+		RegFP32 hit;
+		const RegFP32 t = sphereRoots(ro_Block, ro_Ray, v_TMax, true, hit);
+		const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(hit));
+		if (!mask) return false;
+
+		// Masked horizontal min: misses become +inf, then three min/permute rounds
+		const RegFP32 candidates = _mm256_blendv_ps(_mm256_set1_ps(INFINITY), t, hit);
+		RegFP32 nearest = candidates;
+		nearest = _mm256_min_ps(nearest, _mm256_permute2f128_ps(nearest, nearest, 0x01));
+		nearest = _mm256_min_ps(nearest, _mm256_permute_ps(nearest, _MM_SHUFFLE(1, 0, 3, 2)));
+		nearest = _mm256_min_ps(nearest, _mm256_permute_ps(nearest, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		uint32_t ties = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(candidates, nearest, _CMP_EQ_OQ))) & mask;
+		uint32_t lane = static_cast<uint32_t>(std::countr_zero(ties));
+		for (ties &= ties - 1; ties; ties &= ties - 1) {
+			const uint32_t other = static_cast<uint32_t>(std::countr_zero(ties));
+			if (ro_Block.m_Index[other] < ro_Block.m_Index[lane]) lane = other;
+		}
+
+		ro_T = _mm256_cvtss_f32(nearest);
+		ro_Lane = lane;
+		return true;
+	}
+
+	bool occludedSphereBlock(const SphereBlock& ro_Block, const Ray& ro_Ray, FP32 v_TMax) {
+		RegFP32 hit;
+		sphereRoots(ro_Block, ro_Ray, v_TMax, false, hit);
+		return _mm256_movemask_ps(hit) != 0;
+	}
+
+	RegFP32 intersectSpherePacket(const SphereBlock& ro_Block, uint32_t v_Lane, const RayPacket& ro_Packet, RegFP32 v_TMax, RegFP32& ro_T) {
+		// Same operation order as sphereRoots with the roles swapped: the sphere is broadcast, the rays are lanes
+		const RegFP32 lx = _mm256_sub_ps(ro_Packet.m_Origin.X, _mm256_set1_ps(ro_Block.m_CenterX[v_Lane]));
+		const RegFP32 ly = _mm256_sub_ps(ro_Packet.m_Origin.Y, _mm256_set1_ps(ro_Block.m_CenterY[v_Lane]));
+		const RegFP32 lz = _mm256_sub_ps(ro_Packet.m_Origin.Z, _mm256_set1_ps(ro_Block.m_CenterZ[v_Lane]));
+
+		const RegFP32 b = _mm256_fmadd_ps(ro_Packet.m_Direction.Z, lz,
+			_mm256_fmadd_ps(ro_Packet.m_Direction.Y, ly, _mm256_mul_ps(ro_Packet.m_Direction.X, lx)));
+		const RegFP32 c = _mm256_sub_ps(_mm256_fmadd_ps(lz, lz, _mm256_fmadd_ps(ly, ly, _mm256_mul_ps(lx, lx))),
+										_mm256_set1_ps(ro_Block.m_RadiusSq[v_Lane]));
+		const RegFP32 det = _mm256_fmsub_ps(b, b, c);
+
+		const RegFP32 root = _mm256_sqrt_ps(_mm256_max_ps(det, _mm256_setzero_ps()));
+		const RegFP32 negB = _mm256_sub_ps(_mm256_setzero_ps(), b);
+		const RegFP32 t0 = _mm256_sub_ps(negB, root);
+		const RegFP32 t1 = _mm256_add_ps(negB, root);
+
+		const RegFP32 epsilon = _mm256_set1_ps(kEpsilon);
+		ro_T = _mm256_blendv_ps(t1, t0, _mm256_cmp_ps(t0, epsilon, _CMP_GT_OQ));
+
+		const RegFP32 hit = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(ro_T, epsilon, _CMP_GT_OQ)),
+			_mm256_cmp_ps(ro_T, v_TMax, _CMP_LE_OQ));
+		return _mm256_and_ps(hit, ro_Packet.m_Active);
+	}
+
+	HitRecord captureSphereHit(const SphereBlock& ro_Block, uint32_t v_Lane, const Ray& ro_Ray, FP32 v_T) {
+		const Point3 p = ro_Ray.m_Origin + scale(ro_Ray.m_DirectionCosine, v_T);
+		const Point3 center(ro_Block.m_CenterX[v_Lane], ro_Block.m_CenterY[v_Lane], ro_Block.m_CenterZ[v_Lane]);
+		return HitRecord::captureHit(normalize(p - center), p, v_T, ro_Block.m_MaterialID[v_Lane], ro_Block.m_Index[v_Lane]);
+	}
+}
@@ -0,0 +1,58 @@
+#include <Core.h>
+#include <TileScheduler.h>
+
+namespace WavefrontPT::Threading {
+	TileScheduler::TileScheduler(uint32_t v_Width, uint32_t v_Height, uint32_t v_WorkerCount, uint32_t v_TileSize)
+		: m_Width(v_Width), m_Height(v_Height), m_TileSize(std::max(1u, v_TileSize)),
+		m_TilesX((v_Width + m_TileSize - 1) / m_TileSize), m_TileCount(Threading::tileCount(v_Width, v_Height, m_TileSize)), m_Remaining(0), m_Steals(0) {
+		const uint32_t workerCount = std::max(1u, v_WorkerCount);
+		m_Queues.reserve(workerCount);
+
+		for (uint32_t w = 0; w < workerCount; ++w) {
+			const uint32_t begin = uint32_t(uint64_t(m_TileCount) * w / workerCount);
+			const uint32_t end = uint32_t(uint64_t(m_TileCount) * (w + 1) / workerCount);
+
+			auto& queue = m_Queues.emplace_back(std::make_unique<TileQueue>(std::max(1u, end - begin)));
+			if (!queue->isValid()) std::abort();
+
+			// Pushed back to front so the owner pops its run in scanline order and
+			// thieves take from the far end
+			for (uint32_t i = end; i > begin; --i)
+				queue->push(i - 1);
+		}
+
+		m_Remaining.store(m_TileCount, std::memory_order_relaxed);
+	}
+
+	Tile TileScheduler::tileAt(uint32_t v_Index) const {
+		const uint32_t x0 = (v_Index % m_TilesX) * m_TileSize;
+		const uint32_t y0 = (v_Index / m_TilesX) * m_TileSize;
+		return { x0, y0, std::min(x0 + m_TileSize, m_Width), std::min(y0 + m_TileSize, m_Height) };
+	}
+
+	bool TileScheduler::next(uint32_t v_Worker, Tile& ro_Tile) {
+		const uint32_t workerCount = uint32_t(m_Queues.size());
+		uint32_t index = 0;
+
+		while (m_Remaining.load(std::memory_order_acquire) > 0) {
+			bool claimed = m_Queues[v_Worker]->pop(index);
+
+			// Round-robin over the other workers, starting with the next one
+			for (uint32_t i = 1; !claimed && i < workerCount; ++i) {
+				claimed = m_Queues[(v_Worker + i) % workerCount]->steal(index);
+				if (claimed) m_Steals.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (claimed) {
+				m_Remaining.fetch_sub(1, std::memory_order_acq_rel);
+				ro_Tile = tileAt(index);
+				return true;
+			}
+
+			// Every deque looked empty or we lost the races, the last tiles are in flight elsewhere
+			std::this_thread::yield();
+		}
+
+		return false;
+	}
+}
@@ -37,4 +37,69 @@ namespace WavefrontPT::Math::Transcendentals {
         return quadrantReduction({ s, c }, reduced.quadrant);
     }
 
+    void sincos(const Reg8& r_Rad, Reg8& ro_Sin, Reg8& ro_Cos) {
+        // k = nearest multiple of pi/2, r = x - k * pi/2 in three exact steps
+        const Reg8 k = _mm256_round_ps(_mm256_mul_ps(r_Rad, _mm256_set1_ps(INV_PI_2_F)),
+                                       _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        Reg8 r = _mm256_fnmadd_ps(k, _mm256_set1_ps(PI_2_HI_F), r_Rad);
+        r = _mm256_fnmadd_ps(k, _mm256_set1_ps(PI_2_MID_F), r);
+        r = _mm256_fnmadd_ps(k, _mm256_set1_ps(PI_2_LO_F), r);
+
+        const Reg8 r2 = _mm256_mul_ps(r, r);
+        Reg8 s = _mm256_fmadd_ps(r2, _mm256_set1_ps(SIN_F7), _mm256_set1_ps(SIN_F5));
+        s = _mm256_fmadd_ps(r2, s, _mm256_set1_ps(SIN_F3));
+        s = _mm256_fmadd_ps(_mm256_mul_ps(r2, r), s, r);
+
+        Reg8 c = _mm256_fmadd_ps(r2, _mm256_set1_ps(COS_F8), _mm256_set1_ps(COS_F6));
+        c = _mm256_fmadd_ps(r2, c, _mm256_set1_ps(COS_F4));
+        c = _mm256_fmadd_ps(_mm256_mul_ps(r2, r2), c, _mm256_fnmadd_ps(r2, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+        // Same quadrant mapping as quadrantReduction: odd quadrants swap, sin flips in 2 and 3, cos in 1 and 2
+        const __m256i quadrant = _mm256_cvtps_epi32(k);
+        const Reg8 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+            _mm256_and_si256(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        const Reg8 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+        const Reg8 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_and_si256(_mm256_add_epi32(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+        ro_Sin = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sinSign);
+        ro_Cos = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosSign);
+    }
+
+    static void recordError(SincosErrorBound& ro_Bound, float v_Angle, float v_Sin, float v_Cos) {
+        const double sinError = std::abs(double(v_Sin) - std::sin(double(v_Angle)));
+        const double cosError = std::abs(double(v_Cos) - std::cos(double(v_Angle)));
+        if (std::max(sinError, cosError) > std::max(ro_Bound.m_MaxSin, ro_Bound.m_MaxCos))
+            ro_Bound.m_WorstAngle = v_Angle;
+        ro_Bound.m_MaxSin = std::max(ro_Bound.m_MaxSin, sinError);
+        ro_Bound.m_MaxCos = std::max(ro_Bound.m_MaxCos, cosError);
+    }
+
+    SincosError measureSincosError(float v_Begin, float v_End, uint64_t v_Samples) {
+        SincosError error;
+        if (!v_Samples || !(v_End > v_Begin)) return error;
+
+        const double step = (double(v_End) - double(v_Begin)) / double(v_Samples);
+        alignas(32) float angles[8], sines[8], cosines[8];
+
+        for (uint64_t first = 0; first < v_Samples; first += 8) {
+            const uint32_t lanes = uint32_t(std::min<uint64_t>(8, v_Samples - first));
+            for (uint32_t lane = 0; lane < 8; ++lane)
+                angles[lane] = float(double(v_Begin) + double(first + std::min(lane, lanes - 1)) * step);
+
+            Reg8 sinReg, cosReg;
+            sincos(_mm256_load_ps(angles), sinReg, cosReg);
+            _mm256_store_ps(sines, sinReg);
+            _mm256_store_ps(cosines, cosReg);
+
+            for (uint32_t lane = 0; lane < lanes; ++lane) {
+                recordError(error.m_Vector, angles[lane], sines[lane], cosines[lane]);
+                const std::pair<float, float> scalar = sincos(angles[lane]);
+                recordError(error.m_Scalar, angles[lane], scalar.first, scalar.second);
+            }
+        }
+
+        error.m_Samples = v_Samples;
+        return error;
+    }
 }
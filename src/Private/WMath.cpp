@@ -71,10 +71,10 @@ namespace WavefrontPT::Math {
 	}
 
 	RegFP32 dot(const Stripe3& ro_A, const Stripe3& ro_B) {
-		return { _mm256_fmadd_ps(ro_A.X, ro_B.X,
+		return _mm256_fmadd_ps(ro_A.X, ro_B.X,
 		_mm256_fmadd_ps(ro_A.Y, ro_B.Y,
 		_mm256_fmadd_ps(ro_A.Z, ro_B.Z,
-		_mm256_setzero_ps()))) };
+		_mm256_setzero_ps())));
 	}
 
 	Stripe3 cross(const Stripe3& ro_A, const Stripe3& ro_B) {
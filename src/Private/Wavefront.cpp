@@ -0,0 +1,334 @@
+#include <Core.h>
+#include <Wavefront.h>
+
+#include <bit>
+#include <chrono>
+
+#include "IntegratorOps.h"
+#include "RenderStats.h"
+
+namespace WavefrontPT::Integrator {
+	using namespace WavefrontPT::Math;
+
+	uint32_t traceCameraPacket(const Scene& ro_Scene, const Camera& ro_Camera, const PixelStats* p_Stats,
+							   size_t v_Width, size_t v_Height, const Threading::Tile& ro_Tile, uint32_t v_Block, int v_Sample,
+							   Integrators::Ops::SamplerType v_Sampler, uint32_t* p_Pixels,
+							   Math::RayPacket& ro_Packet, Math::PacketHit& ro_Hit) {
+		WF_PROFILE_SCOPE(Camera);
+		const uint32_t blocksX = (ro_Tile.width() + CAMERA_BLOCK_WIDTH - 1) / CAMERA_BLOCK_WIDTH;
+		const uint32_t x0 = ro_Tile.m_X0 + v_Block % blocksX * CAMERA_BLOCK_WIDTH;
+		const uint32_t y0 = ro_Tile.m_Y0 + v_Block / blocksX * CAMERA_BLOCK_HEIGHT;
+
+		alignas(32) int32_t pixelX[Math::RAY_PACKET_WIDTH];
+		alignas(32) int32_t pixelY[Math::RAY_PACKET_WIDTH];
+		uint32_t active = 0;
+
+		for (uint32_t lane = 0; lane < Math::RAY_PACKET_WIDTH; ++lane) {
+			const size_t x = x0 + lane % CAMERA_BLOCK_WIDTH;
+			const size_t y = y0 + lane / CAMERA_BLOCK_WIDTH;
+			pixelX[lane] = int32_t(x);
+			pixelY[lane] = int32_t(y);
+			if (x >= ro_Tile.m_X1 || y >= ro_Tile.m_Y1) continue;
+
+			const size_t pixel = x + y * v_Width;
+			if (p_Stats[pixel].m_Converged) continue;
+
+			p_Pixels[lane] = uint32_t(pixel);
+			active |= 1u << lane;
+		}
+		if (!active) return 0;
+
+		// Jitter for all 8 pixels at once from their (pixel, sample) sequences
+		const __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(pixelX));
+		const __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(pixelY));
+		const __m256i pixel = _mm256_add_epi32(x, _mm256_mullo_epi32(y, _mm256_set1_epi32(int32_t(v_Width))));
+		Integrators::Ops::PathSampler8 sampler = Integrators::Ops::makePathSampler8(v_Sampler, pixel, _mm256_set1_epi32(v_Sample), 0);
+		RegFP32 jitterX, jitterY;
+		Integrators::Ops::sample2D(sampler, jitterX, jitterY);
+
+		const RegFP32 u = _mm256_div_ps(_mm256_add_ps(_mm256_cvtepi32_ps(x), jitterX), _mm256_set1_ps(FP32(v_Width)));
+		const RegFP32 v = _mm256_div_ps(_mm256_add_ps(_mm256_cvtepi32_ps(y), jitterY), _mm256_set1_ps(FP32(v_Height)));
+
+		ro_Packet = generateCameraPacket(ro_Camera, u, v, Math::laneMask(active));
+		hitScene(ro_Scene, ro_Packet, ro_Hit);
+
+		t_RayCounters.m_CameraRays += uint64_t(std::popcount(active));
+		++t_RayCounters.m_CameraPackets;
+		return active;
+	}
+
+	void generateCameraRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene, const Camera& ro_Camera, const PixelStats* p_Stats,
+							size_t v_Width, size_t v_Height, const Threading::Tile& ro_Tile,
+							uint32_t v_BlockBegin, uint32_t v_BlockEnd, int v_SampleBegin, int v_SampleEnd,
+							Integrators::Ops::SamplerType v_Sampler) {
+		ro_Batch.m_Paths.clear();
+		ro_Batch.m_PixelIndex.clear();
+		ro_Batch.m_Hits.clear();
+		ro_Batch.m_Active.clear();
+
+		Math::RayPacket packet;
+		Math::PacketHit hits;
+		uint32_t pixels[Math::RAY_PACKET_WIDTH];
+
+		// Samples inside the block loop keep every pixel's samples in order, as in the megakernel
+		for (uint32_t block = v_BlockBegin; block < v_BlockEnd; ++block) {
+			for (int s = v_SampleBegin; s < v_SampleEnd; ++s) {
+				uint32_t active = traceCameraPacket(ro_Scene, ro_Camera, p_Stats, v_Width, v_Height, ro_Tile, block, s,
+													v_Sampler, pixels, packet, hits);
+				for (; active; active &= active - 1) {
+					const uint32_t lane = static_cast<uint32_t>(std::countr_zero(active));
+					Payload& payload = ro_Batch.m_Paths.emplace_back(Math::laneRay(packet, lane));
+					payload.m_Sampler = pathSampler(v_Sampler, pixels[lane], s);
+
+					ro_Batch.m_Active.push_back(static_cast<uint32_t>(ro_Batch.m_PixelIndex.size()));
+					ro_Batch.m_PixelIndex.push_back(pixels[lane]);
+					ro_Batch.m_Hits.push_back(Math::laneHit(hits, lane));
+				}
+			}
+		}
+	}
+
+	// Spreads the low 9 bits of v_Value to every third bit
+	static uint32_t spreadBits3(uint32_t v_Value) {
+		v_Value &= 0x1FF;
+		v_Value = (v_Value | (v_Value << 16)) & 0x030000FFu;
+		v_Value = (v_Value | (v_Value << 8)) & 0x0300F00Fu;
+		v_Value = (v_Value | (v_Value << 4)) & 0x030C30C3u;
+		v_Value = (v_Value | (v_Value << 2)) & 0x09249249u;
+		return v_Value;
+	}
+
+	uint32_t raySortKey(const Math::Ray& ro_Ray, const Geometry::AABB& ro_Bounds) {
+		const FP32 origin[3] = { ro_Ray.m_Origin.X, ro_Ray.m_Origin.Y, ro_Ray.m_Origin.Z };
+		const FP32 cellCount = FP32(1u << RAY_SORT_CELL_BITS);
+		uint32_t morton = 0;
+		for (int a = 0; a < 3; ++a) {
+			const FP32 extent = ro_Bounds.m_Max[a] - ro_Bounds.m_Min[a];
+			const FP32 cell = extent > 0.0f ? (origin[a] - ro_Bounds.m_Min[a]) * (cellCount / extent) : 0.0f;
+			const uint32_t quantized = uint32_t(std::clamp(cell, 0.0f, cellCount - 1.0f));
+			morton |= spreadBits3(quantized) << a;
+		}
+
+		const Vector3& dir = ro_Ray.m_DirectionCosine;
+		const uint32_t octant = uint32_t(dir.X < 0.0f) | uint32_t(dir.Y < 0.0f) << 1 | uint32_t(dir.Z < 0.0f) << 2;
+		return octant << (3 * RAY_SORT_CELL_BITS) | morton;
+	}
+
+	void sortRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene) {
+		const uint32_t count = uint32_t(ro_Batch.m_Active.size());
+		if (count < 2) return;
+		const auto start = std::chrono::steady_clock::now();
+		const Geometry::AABB bounds = ro_Scene.m_BVH.isEmpty() ? Geometry::AABB() : ro_Scene.m_BVH.m_Nodes[0].m_Bounds;
+
+		uint64_t* keys = ro_Batch.m_SortKeys.begin();
+		uint64_t* scratch = ro_Batch.m_SortScratch.begin();
+		for (uint32_t i = 0; i < count; ++i) {
+			const uint32_t index = ro_Batch.m_Active[i];
+			keys[i] = uint64_t(raySortKey(ro_Batch.m_Paths[index].m_CurrentRay, bounds)) << 32 | index;
+		}
+
+		// LSD passes over the 3 + 3 * RAY_SORT_CELL_BITS key bits, a digit shared by every key is skipped
+		constexpr uint32_t keyBits = 3 + 3 * RAY_SORT_CELL_BITS;
+		constexpr uint32_t digitCount = 1u << RAY_SORT_DIGIT_BITS;
+		for (uint32_t shift = 32; shift < 32 + keyBits; shift += RAY_SORT_DIGIT_BITS) {
+			uint32_t offsets[digitCount] = {};
+			for (uint32_t i = 0; i < count; ++i)
+				++offsets[(keys[i] >> shift) & (digitCount - 1)];
+			if (offsets[(keys[0] >> shift) & (digitCount - 1)] == count) continue;
+
+			uint32_t sum = 0;
+			for (uint32_t& offset : offsets)
+				sum += std::exchange(offset, sum);
+			for (uint32_t i = 0; i < count; ++i)
+				scratch[offsets[(keys[i] >> shift) & (digitCount - 1)]++] = keys[i];
+			std::swap(keys, scratch);
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+			ro_Batch.m_Active[i] = uint32_t(keys[i]);
+
+		t_RayCounters.m_SortedRays += count;
+		t_RayCounters.m_SortNs += uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+
+	void extendRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene) {
+		const bool counted = t_CacheMisses.open();
+		const uint64_t missesBefore = t_CacheMisses.read();
+		const auto start = std::chrono::steady_clock::now();
+
+		for (uint32_t index : ro_Batch.m_Active)
+			ro_Batch.m_Hits[index] = hitScene(ro_Scene, ro_Batch.m_Paths[index].m_CurrentRay);
+
+		t_RayCounters.m_ExtensionNs += uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count());
+		t_RayCounters.m_ExtensionRays += ro_Batch.m_Active.size();
+		if (counted) {
+			t_RayCounters.m_ExtensionCacheMisses += t_CacheMisses.read() - missesBefore;
+			t_RayCounters.m_CountedExtensionRays += ro_Batch.m_Active.size();
+		}
+	}
+
+	static void bucketHits(WavefrontBatch& ro_Batch, const Scene& ro_Scene) {
+		for (RayQueue& bucket : ro_Batch.m_Buckets)
+			bucket.clear();
+
+		for (uint32_t index : ro_Batch.m_Active) {
+			const Math::HitRecord& hit = ro_Batch.m_Hits[index];
+			const uint32_t bucket = hit.m_Hit ? shadeBucket(Materials::classify(ro_Scene.m_Materials[hit.m_MatID])) : SHADE_BUCKET_MISS;
+			ro_Batch.m_Buckets[bucket].push_back(index);
+		}
+	}
+
+	// Moves the paths of ro_Bucket that still carry throughput into m_Next
+	static void pushSurvivors(WavefrontBatch& ro_Batch, const RayQueue& ro_Bucket, bool v_Roulette) {
+		for (uint32_t index : ro_Bucket) {
+			Payload& payload = ro_Batch.m_Paths[index];
+			if (maxFast(payload.m_Throughput.X,
+						maxFast(payload.m_Throughput.Y, payload.m_Throughput.Z)) < kEpsilon) {
+				WF_PROFILE_COUNT(m_TerminatedThroughput, 1);
+				continue;
+			}
+			if (v_Roulette && !surviveRoulette(payload))
+				continue;
+
+			ro_Batch.m_Next.push_back(index);
+		}
+	}
+
+	template<Materials::MaterialClass Class>
+	static void shadeSurfaceBucket(WavefrontBatch& ro_Batch, const Scene& ro_Scene, bool v_Roulette) {
+		const RayQueue& bucket = ro_Batch.m_Buckets[shadeBucket(Class)];
+
+		// Matches evaluateMaterialResponse: no light, no bounce
+		if (ro_Scene.m_Lights.isEmpty()) {
+			pushSurvivors(ro_Batch, bucket, v_Roulette);
+			return;
+		}
+
+		for (uint32_t index : bucket) {
+			Payload& payload = ro_Batch.m_Paths[index];
+			const Math::HitRecord& hit = ro_Batch.m_Hits[index];
+
+			ShadowRay shadow;
+			if (sampleDirectLight<Class>(ro_Scene, payload, hit, ro_Scene.m_Materials[hit.m_MatID], shadow)) {
+				shadow.m_PathIndex = index;
+				ro_Batch.m_ShadowQueue.push_back(shadow);
+			}
+		}
+
+		if constexpr (Class == Materials::MaterialClass::Metal) {
+			// GGX sampling runs 8 hits per call
+			Payload* paths[Math::RAY_PACKET_WIDTH];
+			const Math::HitRecord* hits[Math::RAY_PACKET_WIDTH];
+			const Materials::Material* mats[Math::RAY_PACKET_WIDTH];
+			for (size_t begin = 0; begin < bucket.size(); begin += Math::RAY_PACKET_WIDTH) {
+				const uint32_t count = uint32_t(std::min<size_t>(Math::RAY_PACKET_WIDTH, bucket.size() - begin));
+				for (uint32_t lane = 0; lane < count; ++lane) {
+					const uint32_t index = bucket[begin + lane];
+					paths[lane] = &ro_Batch.m_Paths[index];
+					hits[lane] = &ro_Batch.m_Hits[index];
+					mats[lane] = &ro_Scene.m_Materials[hits[lane]->m_MatID];
+				}
+				sampleMetalBounces(paths, hits, mats, count);
+			}
+		}
+		else {
+			for (uint32_t index : bucket) {
+				const Math::HitRecord& hit = ro_Batch.m_Hits[index];
+				sampleBounce<Class>(ro_Batch.m_Paths[index], hit, ro_Scene.m_Materials[hit.m_MatID]);
+			}
+		}
+
+		pushSurvivors(ro_Batch, bucket, v_Roulette);
+	}
+
+	void shadeHits(WavefrontBatch& ro_Batch, const Scene& ro_Scene, bool v_Roulette) {
+		WF_PROFILE_SCOPE(Shading);
+		ro_Batch.m_Next.clear();
+		ro_Batch.m_ShadowQueue.clear();
+
+		bucketHits(ro_Batch, ro_Scene);
+
+		for (uint32_t index : ro_Batch.m_Buckets[SHADE_BUCKET_MISS])
+			shadeMiss(ro_Batch.m_Paths[index]);
+
+		for (uint32_t index : ro_Batch.m_Buckets[shadeBucket(Materials::MaterialClass::Emissive)])
+			shadeEmission(ro_Batch.m_Paths[index], ro_Scene.m_Materials[ro_Batch.m_Hits[index].m_MatID]);
+
+		shadeSurfaceBucket<Materials::MaterialClass::Diffuse>(ro_Batch, ro_Scene, v_Roulette);
+		shadeSurfaceBucket<Materials::MaterialClass::Metal>(ro_Batch, ro_Scene, v_Roulette);
+	}
+
+	void connectShadowRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene) {
+		for (const ShadowRay& shadow : ro_Batch.m_ShadowQueue) {
+			if (!traceShadowRay(ro_Scene, shadow)) continue;
+			Payload& payload = ro_Batch.m_Paths[shadow.m_PathIndex];
+			payload.m_Radiance = payload.m_Radiance + shadow.m_Contribution;
+		}
+	}
+
+	void renderWavefrontTile(
+		Memory::FrameArena& ro_Arena,
+		const Scene& ro_Scene,
+		AccumulationBuffer& ro_Accumulation,
+		const Threading::Tile& ro_Tile,
+		size_t v_Width,
+		size_t v_Height,
+		int v_SampleBegin,
+		int v_SampleEnd,
+		int v_MaxBounces,
+		int v_RouletteDepth,
+		FP32 v_AdaptiveThreshold,
+		Integrators::Ops::SamplerType v_Sampler,
+		bool v_SortRays,
+		const Camera& ro_Camera) {
+		// Passes with more samples than a batch holds split every block's samples into chunks,
+		// so the batch never exceeds WAVEFRONT_BATCH_SIZE paths whatever the pass size
+		constexpr int chunkSamples = int(WAVEFRONT_BATCH_SIZE / Math::RAY_PACKET_WIDTH);
+		const size_t pathsPerBlock = size_t(std::min(v_SampleEnd - v_SampleBegin, chunkSamples)) * Math::RAY_PACKET_WIDTH;
+		const uint32_t blocksPerBatch = uint32_t(WAVEFRONT_BATCH_SIZE / pathsPerBlock);
+		const uint32_t blockEnd = cameraBlockCount(ro_Tile);
+
+		ro_Arena.reset();
+		WavefrontBatch batch;
+		if (!batch.allocate(ro_Arena, uint32_t(std::min<size_t>(blocksPerBatch, blockEnd) * pathsPerBlock)))
+			std::abort();
+
+		for (uint32_t blockBegin = 0; blockBegin < blockEnd; blockBegin += blocksPerBatch) {
+			uint32_t batchEnd = std::min(blockBegin + blocksPerBatch, blockEnd);
+
+			// Chunks run in sample order, so every pixel still accumulates its samples in order
+			for (int chunkBegin = v_SampleBegin; chunkBegin < v_SampleEnd;) {
+				const int chunkEnd = v_SampleEnd - chunkBegin > chunkSamples ? chunkBegin + chunkSamples : v_SampleEnd;
+
+				generateCameraRays(batch, ro_Scene, ro_Camera, ro_Accumulation.m_Stats, v_Width, v_Height, ro_Tile, blockBegin, batchEnd,
+								   chunkBegin, chunkEnd, v_Sampler);
+
+				for (int bounce = 0; bounce < v_MaxBounces && !batch.m_Active.empty(); ++bounce) {
+					// The first hits come with the camera packets
+					if (bounce > 0) {
+						if (v_SortRays) sortRays(batch, ro_Scene);
+						extendRays(batch, ro_Scene);
+					}
+					shadeHits(batch, ro_Scene, rouletteAfter(bounce, v_RouletteDepth, v_MaxBounces));
+					connectShadowRays(batch, ro_Scene);
+					std::swap(batch.m_Active, batch.m_Next);
+				}
+				// Still active only if the bounce limit stopped the loop
+				WF_PROFILE_COUNT(m_TerminatedMaxBounce, batch.m_Active.size());
+
+				for (size_t i = 0; i < batch.m_Paths.size(); ++i) {
+					const uint32_t pixel = batch.m_PixelIndex[i];
+					ro_Accumulation.m_Sum[pixel] = ro_Accumulation.m_Sum[pixel] + batch.m_Paths[i].m_Radiance;
+					addSample(ro_Accumulation.m_Stats[pixel], batch.m_Paths[i].m_Radiance);
+				}
+				chunkBegin = chunkEnd;
+			}
+		}
+
+		for (size_t y = ro_Tile.m_Y0; y < ro_Tile.m_Y1; ++y)
+			for (size_t x = ro_Tile.m_X0; x < ro_Tile.m_X1; ++x)
+				testConvergence(ro_Accumulation.m_Stats[x + y * v_Width], v_AdaptiveThreshold);
+	}
+}
@@ -0,0 +1,540 @@
+#include <Core.h>
+#include <WideBVH.h>
+
+#include <bit>
+
+#include "Intersection.h"
+#include "RenderStats.h"
+
+namespace WavefrontPT::Geometry {
+	using namespace Integrator::Math;
+
+	// Wide nodes and sphere blocks committed per arena growth step
+	constexpr size_t kWideCommitChunk = 1024;
+
+	// Direction components below this are nudged so 1 / d stays finite and 0 * (1 / d) never yields NaN
+	constexpr FP32 kMinDirection = 1e-20f;
+
+	static void clearSlot(BVH8Node& ro_Node, uint32_t v_Slot) {
+		ro_Node.m_MinX[v_Slot] = ro_Node.m_MinY[v_Slot] = ro_Node.m_MinZ[v_Slot] = INFINITY;
+		ro_Node.m_MaxX[v_Slot] = ro_Node.m_MaxY[v_Slot] = ro_Node.m_MaxZ[v_Slot] = -INFINITY;
+		ro_Node.m_Child[v_Slot] = BVH8_EMPTY_SLOT;
+		ro_Node.m_Count[v_Slot] = 0;
+	}
+
+	static void setSlotBounds(BVH8Node& ro_Node, uint32_t v_Slot, const AABB& ro_Box) {
+		ro_Node.m_MinX[v_Slot] = ro_Box.m_Min[0];
+		ro_Node.m_MinY[v_Slot] = ro_Box.m_Min[1];
+		ro_Node.m_MinZ[v_Slot] = ro_Box.m_Min[2];
+		ro_Node.m_MaxX[v_Slot] = ro_Box.m_Max[0];
+		ro_Node.m_MaxY[v_Slot] = ro_Box.m_Max[1];
+		ro_Node.m_MaxZ[v_Slot] = ro_Box.m_Max[2];
+	}
+
+	static uint32_t allocateWideNode(BVH8& ro_Wide) {
+		const uint32_t index = ro_Wide.m_NodeCount++;
+		Memory::ArenaWalker<BVH8Node>& arena = ro_Wide.m_NodeArena;
+		if (arena.committedCount() < ro_Wide.m_NodeCount) {
+			const size_t remaining = arena.reservedCount() - arena.committedCount();
+			// The reservation covers one wide node per binary interior node
+			if (!arena.commitForward(std::min(kWideCommitChunk, remaining))) std::abort();
+		}
+		BVH8Node& node = ro_Wide.m_Nodes[index];
+		for (uint32_t slot = 0; slot < BVH8_WIDTH; ++slot) clearSlot(node, slot);
+		return index;
+	}
+
+	// Splits a binary leaf into sphere blocks and plane refs, returns its index in m_Leaves
+	static uint32_t emitLeaf(BVH8& ro_Wide, const BVH& ro_Binary, const BVHNode& ro_Leaf, const GSphere* p_Spheres,
+							 uint64_t& ro_FilledLanes) {
+		BVH8Leaf leaf{ ro_Wide.m_SphereBlockCount, 0, uint32_t(ro_Wide.m_Primitives.size()), 0 };
+		uint32_t lane = SPHERE_BLOCK_WIDTH;
+
+		for (uint32_t i = 0; i < ro_Leaf.m_Count; ++i) {
+			const PrimitiveRef& ref = ro_Binary.m_Primitives[ro_Leaf.m_Offset + i];
+			if (ref.m_Type == PrimitiveType::Plane) {
+				ro_Wide.m_Primitives.push_back(ref);
+				++leaf.m_PlaneCount;
+				continue;
+			}
+
+			if (lane == SPHERE_BLOCK_WIDTH) {
+				Memory::ArenaWalker<SphereBlock>& arena = ro_Wide.m_SphereBlockArena;
+				if (arena.committedCount() <= ro_Wide.m_SphereBlockCount) {
+					const size_t remaining = arena.reservedCount() - arena.committedCount();
+					if (!arena.commitForward(std::min(kWideCommitChunk, remaining))) std::abort();
+				}
+				clearSphereBlock(ro_Wide.m_SphereBlocks[ro_Wide.m_SphereBlockCount++]);
+				++leaf.m_SphereBlockCount;
+				lane = 0;
+			}
+			setSphereLane(ro_Wide.m_SphereBlocks[ro_Wide.m_SphereBlockCount - 1], lane++, p_Spheres[ref.m_Index], ref.m_Index);
+			++ro_FilledLanes;
+		}
+
+		ro_Wide.m_Leaves.push_back(leaf);
+		return uint32_t(ro_Wide.m_Leaves.size() - 1);
+	}
+
+	BVH8 collapseBVH(const BVH& ro_Binary, const GSphere* p_Spheres) {
+		BVH8 wide;
+		if (ro_Binary.isEmpty()) return wide;
+
+		const auto startTime = std::chrono::steady_clock::now();
+
+		if (!wide.m_NodeArena.reserve(std::max<size_t>(1, ro_Binary.m_NodeCount) * sizeof(BVH8Node))) return wide;
+		wide.m_NodeArena.adviseHugePages();
+		wide.m_Nodes = wide.m_NodeArena.data();
+
+		// A leaf of n spheres takes at most n / 8 + 1 blocks
+		const size_t maxBlocks = ro_Binary.m_Primitives.size() / SPHERE_BLOCK_WIDTH + ro_Binary.m_Stats.m_LeafCount + 1;
+		if (!wide.m_SphereBlockArena.reserve(maxBlocks * sizeof(SphereBlock))) return wide;
+		wide.m_SphereBlocks = wide.m_SphereBlockArena.data();
+		wide.m_RootBounds = ro_Binary.m_Nodes[0].m_Bounds;
+
+		struct Pending {
+			uint32_t m_Wide;
+			uint32_t m_Binary;
+		};
+		std::vector<Pending> pending;
+		pending.push_back({ allocateWideNode(wide), 0 });
+
+		uint64_t filledSlots = 0;
+		uint64_t filledLanes = 0;
+
+		while (!pending.empty()) {
+			const Pending job = pending.back();
+			pending.pop_back();
+
+			uint32_t children[BVH8_WIDTH];
+			uint32_t childCount = 0;
+
+			const BVHNode& source = ro_Binary.m_Nodes[job.m_Binary];
+			if (source.isLeaf()) {
+				children[childCount++] = job.m_Binary;
+			} else {
+				children[childCount++] = source.m_Offset;
+				children[childCount++] = source.m_Offset + 1;
+			}
+
+			// Open the largest interior child until every slot is used
+			while (childCount < BVH8_WIDTH) {
+				int best = -1;
+				FP32 bestArea = -1.0f;
+				for (uint32_t c = 0; c < childCount; ++c) {
+					const BVHNode& child = ro_Binary.m_Nodes[children[c]];
+					if (child.isLeaf()) continue;
+					FP32 area = child.m_Bounds.surfaceArea();
+					if (area > bestArea) {
+						bestArea = area;
+						best = static_cast<int>(c);
+					}
+				}
+				if (best < 0) break;
+
+				const BVHNode& opened = ro_Binary.m_Nodes[children[best]];
+				children[best] = opened.m_Offset;
+				children[childCount++] = opened.m_Offset + 1;
+			}
+
+			for (uint32_t c = 0; c < childCount; ++c) {
+				const BVHNode& child = ro_Binary.m_Nodes[children[c]];
+				// Allocation may commit, fetch the node pointer after it
+				uint32_t target = BVH8_EMPTY_SLOT;
+				if (!child.isLeaf()) {
+					target = allocateWideNode(wide);
+					pending.push_back({ target, children[c] });
+				} else target = emitLeaf(wide, ro_Binary, child, p_Spheres, filledLanes);
+
+				BVH8Node& node = wide.m_Nodes[job.m_Wide];
+				setSlotBounds(node, c, child.m_Bounds);
+				if (child.isLeaf()) {
+					node.m_Child[c] = target;
+					node.m_Count[c] = child.m_Count;
+				} else {
+					node.m_Child[c] = target;
+					node.m_Count[c] = 0;
+				}
+			}
+			filledSlots += childCount;
+		}
+
+		const auto endTime = std::chrono::steady_clock::now();
+		wide.m_Stats.m_NodeCount = wide.m_NodeCount;
+		wide.m_Stats.m_AverageFill = FP32(double(filledSlots) / double(wide.m_NodeCount));
+		wide.m_Stats.m_SphereBlockCount = wide.m_SphereBlockCount;
+		wide.m_Stats.m_SphereLaneFill = wide.m_SphereBlockCount
+			? FP32(double(filledLanes) / double(uint64_t(wide.m_SphereBlockCount) * SPHERE_BLOCK_WIDTH)) : 0.0f;
+		wide.m_Stats.m_CollapseMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		return wide;
+	}
+
+	HitRecord intersect(const BVH8& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes, const Ray& ro_Ray) {
+		HitRecord closest = HitRecord::captureMiss();
+		if (ro_BVH.isEmpty()) return closest;
+
+		uint64_t closestKey = UINT64_MAX;
+
+		const FP32 dir[3] = { ro_Ray.m_DirectionCosine.X, ro_Ray.m_DirectionCosine.Y, ro_Ray.m_DirectionCosine.Z };
+		const FP32 org[3] = { ro_Ray.m_Origin.X, ro_Ray.m_Origin.Y, ro_Ray.m_Origin.Z };
+
+		FP32 inv[3];
+		for (int a = 0; a < 3; ++a)
+			inv[a] = 1.0f / (absFast(dir[a]) < kMinDirection ? std::copysign(kMinDirection, dir[a]) : dir[a]);
+
+		// Per-ray near/far plane selection replaces the min/max swap, and keeps empty slots
+		// (+inf min, -inf max) inverted for either direction sign
+		const bool negX = inv[0] < 0.0f, negY = inv[1] < 0.0f, negZ = inv[2] < 0.0f;
+
+		const RegFP32 invX = _mm256_set1_ps(inv[0]);
+		const RegFP32 invY = _mm256_set1_ps(inv[1]);
+		const RegFP32 invZ = _mm256_set1_ps(inv[2]);
+		const RegFP32 orgX = _mm256_set1_ps(org[0]);
+		const RegFP32 orgY = _mm256_set1_ps(org[1]);
+		const RegFP32 orgZ = _mm256_set1_ps(org[2]);
+		const RegFP32 zero = _mm256_setzero_ps();
+
+		struct StackEntry {
+			uint32_t m_Offset;
+			uint32_t m_Count;
+			FP32 m_TEntry;
+		};
+		StackEntry stack[BVH8_WIDTH * BVH_MAX_DEPTH];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = { 0, 0, 0.0f };
+
+		while (stackSize) {
+			const StackEntry entry = stack[--stackSize];
+			if (entry.m_TEntry > closest.m_T) continue;
+
+			if (entry.m_Count) {
+				const BVH8Leaf& leaf = ro_BVH.m_Leaves[entry.m_Offset];
+				WF_PROFILE_COUNT(m_SphereBlockTests, leaf.m_SphereBlockCount);
+				WF_PROFILE_COUNT(m_PlaneTests, leaf.m_PlaneCount);
+				for (uint32_t b = 0; b < leaf.m_SphereBlockCount; ++b) {
+					const SphereBlock& block = ro_BVH.m_SphereBlocks[leaf.m_SphereBlock + b];
+					FP32 t;
+					uint32_t lane;
+					if (!intersectSphereBlock(block, ro_Ray, closest.m_T, t, lane)) continue;
+
+					// Sphere order keys are the bare index, matching intersectPrimitives
+					const uint64_t key = block.m_Index[lane];
+					if (t < closest.m_T || (t == closest.m_T && key < closestKey)) {
+						closest = captureSphereHit(block, lane, ro_Ray, t);
+						closestKey = key;
+					}
+				}
+				intersectPrimitives(ro_BVH.m_Primitives.data() + leaf.m_PlaneOffset, leaf.m_PlaneCount,
+									p_Spheres, p_Planes, ro_Ray, closest, closestKey);
+				continue;
+			}
+
+			const BVH8Node& node = ro_BVH.m_Nodes[entry.m_Offset];
+			WF_PROFILE_COUNT(m_NodeTests, 1);
+
+			const RegFP32 nearX = _mm256_load_ps(negX ? node.m_MaxX : node.m_MinX);
+			const RegFP32 nearY = _mm256_load_ps(negY ? node.m_MaxY : node.m_MinY);
+			const RegFP32 nearZ = _mm256_load_ps(negZ ? node.m_MaxZ : node.m_MinZ);
+			const RegFP32 farX = _mm256_load_ps(negX ? node.m_MinX : node.m_MaxX);
+			const RegFP32 farY = _mm256_load_ps(negY ? node.m_MinY : node.m_MaxY);
+			const RegFP32 farZ = _mm256_load_ps(negZ ? node.m_MinZ : node.m_MaxZ);
+
+			RegFP32 tNear = _mm256_max_ps(
+				_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(nearX, orgX), invX), _mm256_mul_ps(_mm256_sub_ps(nearY, orgY), invY)),
+				_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(nearZ, orgZ), invZ), zero));
+			RegFP32 tFar = _mm256_min_ps(
+				_mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(farX, orgX), invX), _mm256_mul_ps(_mm256_sub_ps(farY, orgY), invY)),
+				_mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(farZ, orgZ), invZ), _mm256_set1_ps(closest.m_T)));
+
+			uint32_t hitMask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)));
+			if (!hitMask) continue;
+
+			alignas(32) FP32 entryT[BVH8_WIDTH];
+			_mm256_store_ps(entryT, tNear);
+
+			// Insertion sort of the hit children, nearest first
+			uint32_t order[BVH8_WIDTH];
+			uint32_t hitCount = 0;
+			while (hitMask) {
+				const uint32_t slot = static_cast<uint32_t>(std::countr_zero(hitMask));
+				hitMask &= hitMask - 1;
+				uint32_t i = hitCount++;
+				while (i > 0 && entryT[order[i - 1]] > entryT[slot]) {
+					order[i] = order[i - 1];
+					--i;
+				}
+				order[i] = slot;
+			}
+
+			// Far children go on the stack first so the nearest is popped next
+			for (uint32_t i = hitCount; i > 0; --i) {
+				const uint32_t slot = order[i - 1];
+				stack[stackSize++] = { node.m_Child[slot], node.m_Count[slot], entryT[slot] };
+			}
+		}
+
+		return closest;
+	}
+
+	bool occluded(const BVH8& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes, const Ray& ro_Ray, FP32 v_TMax) {
+		if (ro_BVH.isEmpty()) return false;
+
+		const FP32 dir[3] = { ro_Ray.m_DirectionCosine.X, ro_Ray.m_DirectionCosine.Y, ro_Ray.m_DirectionCosine.Z };
+
+		FP32 inv[3];
+		for (int a = 0; a < 3; ++a)
+			inv[a] = 1.0f / (absFast(dir[a]) < kMinDirection ? std::copysign(kMinDirection, dir[a]) : dir[a]);
+
+		const bool negX = inv[0] < 0.0f, negY = inv[1] < 0.0f, negZ = inv[2] < 0.0f;
+
+		const RegFP32 invX = _mm256_set1_ps(inv[0]);
+		const RegFP32 invY = _mm256_set1_ps(inv[1]);
+		const RegFP32 invZ = _mm256_set1_ps(inv[2]);
+		const RegFP32 orgX = _mm256_set1_ps(ro_Ray.m_Origin.X);
+		const RegFP32 orgY = _mm256_set1_ps(ro_Ray.m_Origin.Y);
+		const RegFP32 orgZ = _mm256_set1_ps(ro_Ray.m_Origin.Z);
+		const RegFP32 zero = _mm256_setzero_ps();
+		const RegFP32 tMax = _mm256_set1_ps(v_TMax);
+
+		struct StackEntry {
+			uint32_t m_Offset;
+			uint32_t m_Count;
+		};
+		StackEntry stack[BVH8_WIDTH * BVH_MAX_DEPTH];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = { 0, 0 };
+
+		// Children are pushed in slot order, the first blocker found ends the walk
+		while (stackSize) {
+			const StackEntry entry = stack[--stackSize];
+
+			if (entry.m_Count) {
+				const BVH8Leaf& leaf = ro_BVH.m_Leaves[entry.m_Offset];
+				WF_PROFILE_COUNT(m_SphereBlockTests, leaf.m_SphereBlockCount);
+				WF_PROFILE_COUNT(m_PlaneTests, leaf.m_PlaneCount);
+				for (uint32_t b = 0; b < leaf.m_SphereBlockCount; ++b)
+					if (occludedSphereBlock(ro_BVH.m_SphereBlocks[leaf.m_SphereBlock + b], ro_Ray, v_TMax)) return true;
+				if (occludedPrimitives(ro_BVH.m_Primitives.data() + leaf.m_PlaneOffset, leaf.m_PlaneCount,
+									   p_Spheres, p_Planes, ro_Ray, v_TMax))
+					return true;
+				continue;
+			}
+
+			const BVH8Node& node = ro_BVH.m_Nodes[entry.m_Offset];
+			WF_PROFILE_COUNT(m_NodeTests, 1);
+
+			const RegFP32 nearX = _mm256_load_ps(negX ? node.m_MaxX : node.m_MinX);
+			const RegFP32 nearY = _mm256_load_ps(negY ? node.m_MaxY : node.m_MinY);
+			const RegFP32 nearZ = _mm256_load_ps(negZ ? node.m_MaxZ : node.m_MinZ);
+			const RegFP32 farX = _mm256_load_ps(negX ? node.m_MinX : node.m_MaxX);
+			const RegFP32 farY = _mm256_load_ps(negY ? node.m_MinY : node.m_MaxY);
+			const RegFP32 farZ = _mm256_load_ps(negZ ? node.m_MinZ : node.m_MaxZ);
+
+			RegFP32 tNear = _mm256_max_ps(
+				_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(nearX, orgX), invX), _mm256_mul_ps(_mm256_sub_ps(nearY, orgY), invY)),
+				_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(nearZ, orgZ), invZ), zero));
+			RegFP32 tFar = _mm256_min_ps(
+				_mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(farX, orgX), invX), _mm256_mul_ps(_mm256_sub_ps(farY, orgY), invY)),
+				_mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(farZ, orgZ), invZ), tMax));
+
+			uint32_t hitMask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)));
+			while (hitMask) {
+				const uint32_t slot = static_cast<uint32_t>(std::countr_zero(hitMask));
+				hitMask &= hitMask - 1;
+				stack[stackSize++] = { node.m_Child[slot], node.m_Count[slot] };
+			}
+		}
+
+		return false;
+	}
+
+	// Per-lane closest hit while a packet walks the tree. Keys order primitives like the linear
+	// scan: spheres by index, then planes by index with the top bit set
+	struct PacketClosest {
+		RegFP32 m_T;
+		__m256i m_Key;
+		__m256i m_MatID;
+		// Sphere center or plane normal, depending on m_IsPlane
+		Stripe3 m_Anchor;
+		RegFP32 m_IsPlane;
+	};
+
+	constexpr uint32_t kPlaneKeyBit = 0x80000000u;
+
+	static void keepCloser(PacketClosest& ro_Closest, RegFP32 v_Hit, RegFP32 v_T, uint32_t v_Key, MaterialID v_MatID,
+						   const Vector3& ro_Anchor, bool v_Plane) {
+		// Unsigned key < closest key, through the signed compare
+		const __m256i flip = _mm256_set1_epi32(int(kPlaneKeyBit));
+		const RegFP32 keyLess = _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+			_mm256_xor_si256(ro_Closest.m_Key, flip), _mm256_set1_epi32(int(v_Key ^ kPlaneKeyBit))));
+		const RegFP32 closer = _mm256_or_ps(_mm256_cmp_ps(v_T, ro_Closest.m_T, _CMP_LT_OQ),
+											_mm256_and_ps(_mm256_cmp_ps(v_T, ro_Closest.m_T, _CMP_EQ_OQ), keyLess));
+		const RegFP32 take = _mm256_and_ps(v_Hit, closer);
+		if (!_mm256_movemask_ps(take)) return;
+
+		auto blendInt = [&](__m256i v_Old, uint32_t v_New) {
+			return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(v_Old),
+														_mm256_castsi256_ps(_mm256_set1_epi32(int(v_New))), take));
+		};
+		ro_Closest.m_T = _mm256_blendv_ps(ro_Closest.m_T, v_T, take);
+		ro_Closest.m_Key = blendInt(ro_Closest.m_Key, v_Key);
+		ro_Closest.m_MatID = blendInt(ro_Closest.m_MatID, v_MatID);
+		ro_Closest.m_Anchor.X = _mm256_blendv_ps(ro_Closest.m_Anchor.X, _mm256_set1_ps(ro_Anchor.X), take);
+		ro_Closest.m_Anchor.Y = _mm256_blendv_ps(ro_Closest.m_Anchor.Y, _mm256_set1_ps(ro_Anchor.Y), take);
+		ro_Closest.m_Anchor.Z = _mm256_blendv_ps(ro_Closest.m_Anchor.Z, _mm256_set1_ps(ro_Anchor.Z), take);
+		ro_Closest.m_IsPlane = _mm256_blendv_ps(ro_Closest.m_IsPlane,
+			v_Plane ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : _mm256_setzero_ps(), take);
+	}
+
+	static FP32 horizontalMin(RegFP32 v_Value) {
+		v_Value = _mm256_min_ps(v_Value, _mm256_permute2f128_ps(v_Value, v_Value, 0x01));
+		v_Value = _mm256_min_ps(v_Value, _mm256_permute_ps(v_Value, _MM_SHUFFLE(1, 0, 3, 2)));
+		v_Value = _mm256_min_ps(v_Value, _mm256_permute_ps(v_Value, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm256_cvtss_f32(v_Value);
+	}
+
+	// Per-lane 1 / d with the same nudge as the single-ray walk
+	static RegFP32 inverseDirection(RegFP32 v_Direction) {
+		const RegFP32 signMask = _mm256_set1_ps(-0.0f);
+		const RegFP32 minDirection = _mm256_set1_ps(kMinDirection);
+		const RegFP32 tiny = _mm256_cmp_ps(_mm256_andnot_ps(signMask, v_Direction), minDirection, _CMP_LT_OQ);
+		const RegFP32 nudged = _mm256_or_ps(_mm256_and_ps(v_Direction, signMask), minDirection);
+		return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_blendv_ps(v_Direction, nudged, tiny));
+	}
+
+	void intersect(const BVH8& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes,
+				   const RayPacket& ro_Packet, PacketHit& ro_Hit) {
+		clearPacketHit(ro_Hit);
+		const uint32_t active = ro_Packet.activeMask();
+		if (ro_BVH.isEmpty() || !active) return;
+
+		const RegFP32 zero = _mm256_setzero_ps();
+		const Stripe3 inv(inverseDirection(ro_Packet.m_Direction.X), inverseDirection(ro_Packet.m_Direction.Y),
+						  inverseDirection(ro_Packet.m_Direction.Z));
+		// Lanes may point anywhere, so the near/far plane selection of the single-ray walk becomes a per-lane blend
+		const RegFP32 negX = _mm256_cmp_ps(inv.X, zero, _CMP_LT_OQ);
+		const RegFP32 negY = _mm256_cmp_ps(inv.Y, zero, _CMP_LT_OQ);
+		const RegFP32 negZ = _mm256_cmp_ps(inv.Z, zero, _CMP_LT_OQ);
+		const Stripe3& org = ro_Packet.m_Origin;
+
+		PacketClosest closest{ _mm256_set1_ps(MISS), _mm256_set1_epi32(-1), _mm256_set1_epi32(int(INVALID_MAT_ID)),
+							   Stripe3(), zero };
+
+		struct StackEntry {
+			uint32_t m_Offset;
+			uint32_t m_Count;
+			uint32_t m_Lanes;
+			FP32 m_TEntry;
+		};
+		StackEntry stack[BVH8_WIDTH * BVH_MAX_DEPTH];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = { 0, 0, active, 0.0f };
+
+		while (stackSize) {
+			const StackEntry entry = stack[--stackSize];
+			// Lanes whose closest hit lies before the subtree's nearest entry are done with it
+			const uint32_t lanes = entry.m_Lanes
+				& static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_set1_ps(entry.m_TEntry), closest.m_T, _CMP_LE_OQ)));
+			if (!lanes) continue;
+			const RegFP32 live = laneMask(lanes);
+
+			if (entry.m_Count) {
+				const BVH8Leaf& leaf = ro_BVH.m_Leaves[entry.m_Offset];
+				WF_PROFILE_COUNT(m_PacketSphereBlockTests, leaf.m_SphereBlockCount);
+				WF_PROFILE_COUNT(m_PacketPlaneTests, leaf.m_PlaneCount);
+				for (uint32_t b = 0; b < leaf.m_SphereBlockCount; ++b) {
+					const SphereBlock& block = ro_BVH.m_SphereBlocks[leaf.m_SphereBlock + b];
+					for (uint32_t lane = 0; lane < SPHERE_BLOCK_WIDTH && block.m_Index[lane] != INVALID_OBJ_ID; ++lane) {
+						RegFP32 t;
+						const RegFP32 hit = _mm256_and_ps(intersectSpherePacket(block, lane, ro_Packet, closest.m_T, t), live);
+						keepCloser(closest, hit, t, block.m_Index[lane], block.m_MaterialID[lane],
+								   Vector3(block.m_CenterX[lane], block.m_CenterY[lane], block.m_CenterZ[lane]), false);
+					}
+				}
+				for (uint32_t i = 0; i < leaf.m_PlaneCount; ++i) {
+					const uint32_t index = ro_BVH.m_Primitives[leaf.m_PlaneOffset + i].m_Index;
+					const GPlane& plane = p_Planes[index];
+					RegFP32 t;
+					const RegFP32 hit = _mm256_and_ps(intersectPlanePacket(ro_Packet, plane, t), live);
+					keepCloser(closest, hit, t, index | kPlaneKeyBit, plane.m_MaterialID, plane.m_SurfaceNormal, true);
+				}
+				continue;
+			}
+
+			const BVH8Node& node = ro_BVH.m_Nodes[entry.m_Offset];
+			WF_PROFILE_COUNT(m_PacketNodeTests, 1);
+
+			FP32 entryT[BVH8_WIDTH];
+			uint32_t childLanes[BVH8_WIDTH];
+			uint32_t order[BVH8_WIDTH];
+			uint32_t hitCount = 0;
+
+			for (uint32_t slot = 0; slot < BVH8_WIDTH; ++slot) {
+				if (node.m_Child[slot] == BVH8_EMPTY_SLOT) continue;
+
+				const RegFP32 minX = _mm256_set1_ps(node.m_MinX[slot]), maxX = _mm256_set1_ps(node.m_MaxX[slot]);
+				const RegFP32 minY = _mm256_set1_ps(node.m_MinY[slot]), maxY = _mm256_set1_ps(node.m_MaxY[slot]);
+				const RegFP32 minZ = _mm256_set1_ps(node.m_MinZ[slot]), maxZ = _mm256_set1_ps(node.m_MaxZ[slot]);
+
+				const RegFP32 tNear = _mm256_max_ps(
+					_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(minX, maxX, negX), org.X), inv.X),
+								  _mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(minY, maxY, negY), org.Y), inv.Y)),
+					_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(minZ, maxZ, negZ), org.Z), inv.Z), zero));
+				const RegFP32 tFar = _mm256_min_ps(
+					_mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(maxX, minX, negX), org.X), inv.X),
+								  _mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(maxY, minY, negY), org.Y), inv.Y)),
+					_mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(maxZ, minZ, negZ), org.Z), inv.Z), closest.m_T));
+
+				const RegFP32 enters = _mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ), live);
+				const uint32_t hitLanes = static_cast<uint32_t>(_mm256_movemask_ps(enters));
+				if (!hitLanes) continue;
+
+				entryT[slot] = horizontalMin(_mm256_blendv_ps(_mm256_set1_ps(INFINITY), tNear, enters));
+				childLanes[slot] = hitLanes;
+
+				// Insertion sort by the earliest entry over the packet, nearest first
+				uint32_t i = hitCount++;
+				while (i > 0 && entryT[order[i - 1]] > entryT[slot]) {
+					order[i] = order[i - 1];
+					--i;
+				}
+				order[i] = slot;
+			}
+
+			for (uint32_t i = hitCount; i > 0; --i) {
+				const uint32_t slot = order[i - 1];
+				stack[stackSize++] = { node.m_Child[slot], node.m_Count[slot], childLanes[slot], entryT[slot] };
+			}
+		}
+
+		const RegFP32 hit = _mm256_cmp_ps(closest.m_T, _mm256_set1_ps(MISS), _CMP_LT_OQ);
+		ro_Hit.m_HitMask = static_cast<uint32_t>(_mm256_movemask_ps(hit));
+		if (!ro_Hit.m_HitMask) return;
+
+		const Stripe3 point = ro_Packet.m_Origin + scale(ro_Packet.m_Direction, closest.m_T);
+
+		// Sphere normals as in the scalar normalize(), plane normals are stored as is
+		const Stripe3 radial = point - closest.m_Anchor;
+		const RegFP32 lengthSq = dot(radial, radial);
+		const RegFP32 invLength = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSq)),
+												_mm256_cmp_ps(lengthSq, _mm256_set1_ps(kEpsilonSq), _CMP_GT_OQ));
+		const Stripe3 sphereNormal = scale(radial, invLength);
+
+		_mm256_store_ps(ro_Hit.m_T, closest.m_T);
+		_mm256_store_ps(ro_Hit.m_NormalX, _mm256_and_ps(_mm256_blendv_ps(sphereNormal.X, closest.m_Anchor.X, closest.m_IsPlane), hit));
+		_mm256_store_ps(ro_Hit.m_NormalY, _mm256_and_ps(_mm256_blendv_ps(sphereNormal.Y, closest.m_Anchor.Y, closest.m_IsPlane), hit));
+		_mm256_store_ps(ro_Hit.m_NormalZ, _mm256_and_ps(_mm256_blendv_ps(sphereNormal.Z, closest.m_Anchor.Z, closest.m_IsPlane), hit));
+		_mm256_store_ps(ro_Hit.m_PointX, _mm256_and_ps(point.X, hit));
+		_mm256_store_ps(ro_Hit.m_PointY, _mm256_and_ps(point.Y, hit));
+		_mm256_store_ps(ro_Hit.m_PointZ, _mm256_and_ps(point.Z, hit));
+		_mm256_store_si256(reinterpret_cast<__m256i*>(ro_Hit.m_MatID), closest.m_MatID);
+
+		alignas(32) uint32_t keys[RAY_PACKET_WIDTH];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(keys), closest.m_Key);
+		for (uint32_t mask = ro_Hit.m_HitMask; mask; mask &= mask - 1) {
+			const uint32_t lane = static_cast<uint32_t>(std::countr_zero(mask));
+			ro_Hit.m_ObjID[lane] = keys[lane] & kPlaneKeyBit ? p_Planes[keys[lane] & ~kPlaneKeyBit].m_ObjectID
+															 : p_Spheres[keys[lane]].m_ObjectID;
+		}
+	}
+}
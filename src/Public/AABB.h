@@ -0,0 +1,58 @@
+#pragma once
+#include "WMath.h"
+
+namespace WavefrontPT::Geometry {
+	// Axis aligned box kept as plain floats, 24 bytes, so BVH nodes stay at 32
+	struct AABB final {
+		Math::FP32 m_Min[3];
+		Math::FP32 m_Max[3];
+
+		AABB() : m_Min{ INFINITY, INFINITY, INFINITY }, m_Max{ -INFINITY, -INFINITY, -INFINITY } {}
+
+		AABB(const Math::Point3& ro_Min, const Math::Point3& ro_Max)
+			: m_Min{ ro_Min.X, ro_Min.Y, ro_Min.Z }, m_Max{ ro_Max.X, ro_Max.Y, ro_Max.Z } {}
+
+		AABB(const AABB&) = default;
+		AABB& operator=(const AABB&) = default;
+		AABB(AABB&&) noexcept = default;
+		AABB& operator=(AABB&&) noexcept = default;
+		~AABB() = default;
+
+		void grow(const AABB& ro_Other) {
+			for (int a = 0; a < 3; ++a) {
+				m_Min[a] = std::min(m_Min[a], ro_Other.m_Min[a]);
+				m_Max[a] = std::max(m_Max[a], ro_Other.m_Max[a]);
+			}
+		}
+
+		void grow(const Math::FP32 (&ro_Point)[3]) {
+			for (int a = 0; a < 3; ++a) {
+				m_Min[a] = std::min(m_Min[a], ro_Point[a]);
+				m_Max[a] = std::max(m_Max[a], ro_Point[a]);
+			}
+		}
+
+		bool isEmpty() const {
+			return m_Min[0] > m_Max[0];
+		}
+
+		Math::FP32 extent(int v_Axis) const {
+			return m_Max[v_Axis] - m_Min[v_Axis];
+		}
+
+		Math::FP32 centroid(int v_Axis) const {
+			return 0.5f * (m_Min[v_Axis] + m_Max[v_Axis]);
+		}
+
+		Math::FP32 surfaceArea() const {
+			if (isEmpty()) return 0.0f;
+			Math::FP32 dx = extent(0), dy = extent(1), dz = extent(2);
+			return 2.0f * (dx * dy + dy * dz + dz * dx);
+		}
+
+		int largestAxis() const {
+			Math::FP32 dx = extent(0), dy = extent(1), dz = extent(2);
+			return (dx >= dy && dx >= dz) ? 0 : (dy >= dz ? 1 : 2);
+		}
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "IntegratorMathCore.h"
+#include "IntegratorOps.h"
+#include "MemoryAllocators.h"
+#include "WMath.h"
+
+namespace WavefrontPT::Integrator {
+	// Mean luminance below this is treated as this, so near-black pixels don't chase a relative error
+	constexpr Math::FP32 ADAPTIVE_MEAN_FLOOR = 0.01f;
+	// Pass size used by adaptive sampling when no --pass-spp is given, the first pass is the warm-up
+	constexpr int ADAPTIVE_DEFAULT_PASS_SAMPLES = 8;
+
+	// Welford running luminance statistics, one per pixel
+	struct PixelStats final {
+		uint32_t m_Samples;
+		Math::FP32 m_Mean;
+		Math::FP32 m_M2;
+		uint32_t m_Converged;
+	};
+
+	inline void addSample(PixelStats& ro_Stats, const Math::Vector3& ro_Radiance) {
+		const Math::FP32 x = Integrators::Ops::luminance(ro_Radiance);
+		++ro_Stats.m_Samples;
+		const Math::FP32 delta = x - ro_Stats.m_Mean;
+		ro_Stats.m_Mean += delta / Math::FP32(ro_Stats.m_Samples);
+		ro_Stats.m_M2 += delta * (x - ro_Stats.m_Mean);
+	}
+
+	// Marks the pixel converged once the standard error of its mean drops below
+	// v_Threshold relative to the mean, v_Threshold == 0 never converges
+	void testConvergence(PixelStats& ro_Stats, Math::FP32 v_Threshold);
+
+	// ----------------------------------------------------------------------------------
+	// Persistent per-pixel radiance sums and sample statistics, shared by every pass.
+	// Both live in committed arena pages, which start out zeroed.
+	// ----------------------------------------------------------------------------------
+	struct AccumulationBuffer final {
+		Memory::ArenaWalker<Math::Vector3> m_SumArena;
+		Memory::ArenaWalker<PixelStats> m_StatsArena;
+		Math::Vector3* m_Sum = nullptr;
+		PixelStats* m_Stats = nullptr;
+		size_t m_Width = 0;
+		size_t m_Height = 0;
+
+		AccumulationBuffer() = default;
+
+		AccumulationBuffer(const AccumulationBuffer&) = delete;
+		AccumulationBuffer& operator=(const AccumulationBuffer&) = delete;
+		AccumulationBuffer(AccumulationBuffer&&) noexcept = default;
+		AccumulationBuffer& operator=(AccumulationBuffer&&) noexcept = default;
+		~AccumulationBuffer() = default;
+
+		bool initialize(size_t v_Width, size_t v_Height);
+
+		size_t pixelCount() const { return m_Width * m_Height; }
+	};
+
+	// Averages every pixel over its own sample count
+	void resolve(const AccumulationBuffer& ro_Buffer, Math::Vector3* p_Image);
+
+	// Per-pixel sample counts from blue (fewest) to red (most)
+	void writeSampleHeatmap(const char* p_Filename, const AccumulationBuffer& ro_Buffer, Math::Vector3* p_Scratch);
+}
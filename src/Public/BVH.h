@@ -0,0 +1,92 @@
+#pragma once
+#include "AABB.h"
+#include "GPlane.h"
+#include "GSphere.h"
+#include "IntegratorMathCore.h"
+#include "MemoryAllocators.h"
+
+namespace WavefrontPT::Geometry {
+	enum class PrimitiveType : uint32_t {
+		Sphere, Plane
+	};
+
+	struct PrimitiveRef final {
+		uint32_t m_Index;
+		PrimitiveType m_Type;
+	};
+
+	// Interior: children live at m_Offset and m_Offset + 1, m_Count == 0
+	// Leaf: m_Count primitives starting at m_Offset in BVH::m_Primitives
+	struct BVHNode final {
+		AABB m_Bounds;
+		uint32_t m_Offset;
+		uint32_t m_Count;
+
+		bool isLeaf() const { return m_Count != 0; }
+	};
+
+	struct BVHBuildStats final {
+		double m_BuildMs = 0.0;
+		uint32_t m_NodeCount = 0;
+		uint32_t m_LeafCount = 0;
+		uint32_t m_MaxDepth = 0;
+		uint32_t m_ThreadCount = 0;
+		Math::FP32 m_SAHCost = 0.0f;
+	};
+
+	// Nodes live in a reserved arena sized for the 2N - 1 worst case and are
+	// committed page-wise as the builder hands them out
+	struct BVH final {
+		Memory::ArenaWalker<BVHNode> m_NodeArena;
+		BVHNode* m_Nodes = nullptr;
+		uint32_t m_NodeCount = 0;
+		std::vector<PrimitiveRef> m_Primitives;
+		BVHBuildStats m_Stats;
+
+		BVH() = default;
+
+		BVH(const BVH&) = delete;
+		BVH& operator=(const BVH&) = delete;
+		BVH(BVH&&) noexcept = default;
+		BVH& operator=(BVH&&) noexcept = default;
+		~BVH() = default;
+
+		bool isEmpty() const { return m_NodeCount == 0; }
+	};
+
+	constexpr uint32_t BVH_MAX_LEAF_SIZE = 8;
+	constexpr uint32_t BVH_MAX_DEPTH = 64;
+	constexpr uint32_t BVH_BIN_COUNT = 32;
+
+	// Nodes above this size bin their centroids across all workers
+	constexpr uint32_t BVH_PARALLEL_BIN_THRESHOLD = 1 << 16;
+	// Subtrees above this size are handed to their own worker
+	constexpr uint32_t BVH_PARALLEL_SUBTREE_THRESHOLD = 1 << 12;
+
+	// SAH costs, relative to one primitive test
+	constexpr Math::FP32 SAH_TRAVERSAL_COST = 1.0f;
+	constexpr Math::FP32 SAH_INTERSECTION_COST = 1.0f;
+
+	AABB bounds(const GSphere& ro_Sphere);
+	AABB bounds(const GPlane& ro_Plane);
+
+	// Binned SAH build over both primitive arrays, v_ThreadCount == 0 uses every hardware thread
+	BVH buildBVH(const GSphere* p_Spheres, size_t v_SphereCount, const GPlane* p_Planes, size_t v_PlaneCount,
+				 unsigned int v_ThreadCount = 0);
+
+	// Leaf kernel shared by every BVH flavour, keeps the linear scan's tie-break on equal t
+	void intersectPrimitives(const PrimitiveRef* p_Refs, uint32_t v_Count, const GSphere* p_Spheres, const GPlane* p_Planes,
+							 const Integrator::Math::Ray& ro_Ray, Integrator::Math::HitRecord& ro_Closest, uint64_t& ro_ClosestKey);
+
+	// Any-hit leaf kernel, stops at the first primitive closer than v_TMax
+	bool occludedPrimitives(const PrimitiveRef* p_Refs, uint32_t v_Count, const GSphere* p_Spheres, const GPlane* p_Planes,
+							const Integrator::Math::Ray& ro_Ray, Math::FP32 v_TMax);
+
+	// Front-to-back closest hit, returns exactly what the linear scan over spheres then planes returns
+	[[nodiscard]] Integrator::Math::HitRecord intersect(const BVH& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes,
+														const Integrator::Math::Ray& ro_Ray);
+
+	// True when anything lies along the ray in [kEpsilon, v_TMax), no HitRecord is built
+	[[nodiscard]] bool occluded(const BVH& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes,
+								const Integrator::Math::Ray& ro_Ray, Math::FP32 v_TMax);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "IntegratorMathCore.h"
+#include "RayPacket.h"
+#include "WMath.h"
+
+namespace WavefrontPT::Integrator {
+	// Pinhole camera, scalar, no matrices
+	struct Camera final {
+		Math::Point3 m_Origin;
+		Math::Point3 m_LowerLeftCorner;
+		Math::Vector3 m_Horizontal;
+		Math::Vector3 m_Vertical;
+
+		Camera() = default;
+
+		Camera(const Math::Point3& ro_Origin, const Math::Point3& ro_LowerLeft,
+			   const Math::Vector3& ro_Horizontal, const Math::Vector3& ro_Vertical)
+			: m_Origin(ro_Origin), m_LowerLeftCorner(ro_LowerLeft),
+			m_Horizontal(ro_Horizontal), m_Vertical(ro_Vertical) {}
+
+		Camera(const Camera&) = default;
+		Camera& operator=(const Camera&) = default;
+		Camera(Camera&&) noexcept = default;
+		Camera& operator=(Camera&&) noexcept = default;
+		~Camera() = default;
+	};
+
+	// Scene-file camera, turned into a Camera once the image aspect is known
+	struct CameraDesc final {
+		Math::Point3 m_Origin = Math::Point3(0.0f, 0.0f, 0.0f);
+		Math::Point3 m_LookAt = Math::Point3(0.0f, 0.0f, -1.0f);
+		Math::Vector3 m_Up = Math::Vector3(0.0f, 1.0f, 0.0f);
+		// Degrees, spanning the full image height at focal distance 1
+		Math::FP32 m_VerticalFov = 90.0f;
+	};
+
+	Camera makeCamera(const CameraDesc& ro_Desc, Math::FP32 v_Aspect);
+
+	// u, v are normalized film coordinates in [0, 1)
+	inline Math::Ray generateCameraRay(const Camera& ro_Camera, Math::FP32 v_U, Math::FP32 v_V) {
+		Math::Point3 pixelPoint = ro_Camera.m_LowerLeftCorner
+			+ Math::scale(ro_Camera.m_Horizontal, v_U)
+			+ Math::scale(ro_Camera.m_Vertical, v_V);
+		return Math::Ray(ro_Camera.m_Origin, Math::normalize(pixelPoint - ro_Camera.m_Origin));
+	}
+
+	// generateCameraRay for 8 film positions at once, v_Active becomes the packet's lane mask
+	Math::RayPacket generateCameraPacket(const Camera& ro_Camera, Math::RegFP32 v_U, Math::RegFP32 v_V, Math::RegFP32 v_Active);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Accumulation.h"
+#include "Integrators.h"
+#include "MappedFile.h"
+
+namespace WavefrontPT::Integrator {
+	constexpr uint32_t CHECKPOINT_MAGIC = 0x54504657; // "WFPT"
+	constexpr uint32_t CHECKPOINT_VERSION = 4;
+
+	// ----------------------------------------------------------------------------------
+	// Page-sized header at the front of the checkpoint file. Everything above m_SlotSamples
+	// identifies the render, a checkpoint only resumes a render that matches it exactly.
+	// Sample seeds depend on the sample index alone, so the sample count is the whole RNG state.
+	// ----------------------------------------------------------------------------------
+	struct CheckpointHeader final {
+		uint32_t m_Magic;
+		uint32_t m_Version;
+		uint64_t m_Width;
+		uint64_t m_Height;
+		uint32_t m_Mode;
+		uint32_t m_MaxBounces;
+		uint32_t m_RouletteDepth;
+		Math::FP32 m_AdaptiveThreshold;
+		uint32_t m_PixelBytes;
+		uint32_t m_Sampler;
+		// SceneIdentity of the scene file, all zero for the built-in demo scene
+		uint64_t m_ScenePathHash;
+		uint64_t m_SceneBytes;
+		int64_t m_SceneTime;
+
+		uint32_t m_SlotSamples[2];
+		uint32_t m_SlotPasses[2];
+		// Active slot + 1, zero until the first pass is published. Storing it is the commit point
+		uint32_t m_Published;
+	};
+
+	// ----------------------------------------------------------------------------------
+	// Accumulation state mirrored into a memory-mapped file at pass boundaries. The file
+	// holds two slots of radiance sums and pixel statistics: a pass is copied into the
+	// slot that is not active, flushed, and only then made active by the header, so a
+	// process killed at any point leaves the last completed pass intact.
+	// The live buffer stays in anonymous memory, the file only ever sees whole passes.
+	// ----------------------------------------------------------------------------------
+	class Checkpoint final {
+		Memory::MappedFile m_File;
+		size_t m_PixelCount = 0;
+		size_t m_SlotBytes = 0;
+
+		CheckpointHeader& header() { return *reinterpret_cast<CheckpointHeader*>(m_File.data()); }
+		const CheckpointHeader& header() const { return *reinterpret_cast<const CheckpointHeader*>(m_File.data()); }
+		std::byte* slot(uint32_t v_Slot) { return m_File.data() + Memory::PAGE_FILE + v_Slot * m_SlotBytes; }
+
+	public:
+		Checkpoint() = default;
+
+		Checkpoint(const Checkpoint&) = delete;
+		Checkpoint& operator=(const Checkpoint&) = delete;
+		Checkpoint(Checkpoint&&) noexcept = default;
+		Checkpoint& operator=(Checkpoint&&) noexcept = default;
+		~Checkpoint() = default;
+
+		// Maps p_Path and restores ro_Buffer from it when it holds a completed pass of the same
+		// render, otherwise starts a fresh file. ro_Buffer must already be initialized
+		bool open(const char* p_Path, IntegratorMode v_Mode, const RenderSettings& ro_Settings,
+				  AccumulationBuffer& ro_Buffer, bool& ro_Resumed);
+		// Publishes ro_Buffer as the state after v_Passes passes and v_SamplesDone samples per pixel
+		bool save(const AccumulationBuffer& ro_Buffer, uint32_t v_SamplesDone, uint32_t v_Passes);
+
+		bool isOpen() const { return m_File.isOpen(); }
+		uint32_t samplesDone() const { return header().m_Published ? header().m_SlotSamples[header().m_Published - 1] : 0; }
+		uint32_t passes() const { return header().m_Published ? header().m_SlotPasses[header().m_Published - 1] : 0; }
+	};
+}
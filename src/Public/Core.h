@@ -23,8 +23,13 @@
 //
 // ----------------------------------------------------------------------------------
 
+#if defined(_MSC_VER)
 #define WF_FORCEINLINE __forceinline
 #define WF_UNREACHABLE() __assume(0)
+#else
+#define WF_FORCEINLINE inline __attribute__((always_inline))
+#define WF_UNREACHABLE() __builtin_unreachable()
+#endif
 #define WF_FALLTHROUGH [[fallthrough]]
 
 
@@ -1,27 +1,18 @@
 #pragma once
 #include <Core.h>
 
-#include "IntegratorMathCore.h"
 #include "WMath.h"
 
-inline void writePPM(
-    const char* filename,
-    const WavefrontPT::Math::Vector3* framebuffer,
-    int width,
-    int height
-) {
-    std::ofstream file(filename, std::ios::out);
-    file << "P3\n" << width << " " << height << "\n255\n";
+namespace WavefrontPT::Output {
+	// Below this many rows per worker the thread start-up costs more than the quantization
+	constexpr size_t OUTPUT_MIN_ROWS_PER_WORKER = 16;
 
-    for (int y = height - 1; y >= 0; --y) {
-        for (int x = 0; x < width; ++x) {
-            const WavefrontPT::Math::Vector3& c = framebuffer[y * width + x];
+	// Clamps to [0, 1] (NaN to 0), applies the sRGB transfer curve and rounds to 8 bits.
+	// p_Out receives 3 * v_Count tightly packed bytes
+	void quantizeSRGB8(const Math::Vector3* p_Pixels, size_t v_Count, uint8_t* p_Out);
 
-            int r = int(255.99f * c.X);
-            int g = int(255.99f * c.Y);
-            int b = int(255.99f * c.Z);
-
-            file << r << " " << g << " " << b << "\n";
-        }
-    }
+	// Binary P6, the framebuffer is stored bottom row first and is flipped on the way out
+	bool writePPM(const char* p_Filename, const Math::Vector3* p_Image, size_t v_Width, size_t v_Height);
+	// Linear little-endian PFM, which is bottom row first like the framebuffer
+	bool writePFM(const char* p_Filename, const Math::Vector3* p_Image, size_t v_Width, size_t v_Height);
 }
@@ -0,0 +1,133 @@
+#pragma once
+#include "MemoryAllocators.h"
+
+#include <new>
+#include <type_traits>
+
+namespace WavefrontPT::Memory {
+	// Address space reserved per arena, only what is touched gets committed
+	constexpr size_t FRAME_ARENA_RESERVE = size_t(1) << 30;
+	// Commit granularity when an allocation runs past the committed head
+	constexpr size_t FRAME_ARENA_COMMIT_CHUNK = size_t(64) << 10;
+
+	// ----------------------------------------------------------------------------------
+	// Per-worker bump allocator for transient render data. allocate() is a pointer
+	// bump, reset() rewinds in O(1) and keeps every committed page, so after the first
+	// few tiles the committed size settles at the high-water mark and the render loop
+	// never calls into the OS or malloc again. Nothing allocated here is destroyed.
+	// ----------------------------------------------------------------------------------
+	class FrameArena final : public AdvancingAllocator<std::byte, FrameArena> {
+		ArenaWalker<std::byte> m_Walker;
+		size_t m_Offset;
+		size_t m_HighWater;
+
+	public:
+		FrameArena() : m_Offset(0), m_HighWater(0) {}
+		~FrameArena() = default;
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+		FrameArena(FrameArena&&) noexcept = default;
+		FrameArena& operator=(FrameArena&&) noexcept = default;
+
+		std::byte* reserve(size_t v_PageSize) {
+			return m_Walker.reserve(v_PageSize);
+		}
+
+		std::byte* commitForward(size_t v_Count) {
+			return m_Walker.commitForward(v_Count);
+		}
+
+		bool decommit(size_t v_Count) {
+			return m_Walker.decommit(v_Count);
+		}
+
+		bool release() {
+			m_Offset = 0;
+			m_HighWater = 0;
+			return m_Walker.release();
+		}
+
+		template<typename ...Params>
+		std::byte* constructAndAdvance(std::byte* p_Memory, Params&&...u_Params) {
+			return m_Walker.constructAndAdvance(p_Memory, std::forward<Params>(u_Params)...);
+		}
+
+		// Uninitialized storage for v_Count objects, nullptr once the reservation is exhausted
+		template<typename T>
+		T* allocate(size_t v_Count) {
+			static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+
+			const size_t begin = (m_Offset + alignof(T) - 1) & ~(alignof(T) - 1);
+			const size_t end = begin + v_Count * sizeof(T);
+
+			const size_t committed = m_Walker.committedCount();
+			if (end > committed) {
+				const size_t grow = std::max(end - committed, FRAME_ARENA_COMMIT_CHUNK);
+				const size_t remaining = m_Walker.reservedCount() - committed;
+				if (end - committed > remaining) return nullptr;
+				if (!m_Walker.commitForward(std::min(grow, remaining))) return nullptr;
+			}
+
+			m_Offset = end;
+			m_HighWater = std::max(m_HighWater, m_Offset);
+			return reinterpret_cast<T*>(m_Walker.data() + begin);
+		}
+
+		void reset() { m_Offset = 0; }
+
+		size_t usedBytes() const { return m_Offset; }
+		size_t highWaterBytes() const { return m_HighWater; }
+		size_t committedBytes() const { return m_Walker.committedCount(); }
+	};
+
+	// Fixed-capacity array carved out of a FrameArena, valid until that arena is reset
+	template<typename T>
+	struct FrameArray final {
+		T* m_Data = nullptr;
+		uint32_t m_Size = 0;
+		uint32_t m_Capacity = 0;
+
+		FrameArray() = default;
+
+		FrameArray(const FrameArray&) = default;
+		FrameArray& operator=(const FrameArray&) = default;
+		FrameArray(FrameArray&&) noexcept = default;
+		FrameArray& operator=(FrameArray&&) noexcept = default;
+		~FrameArray() = default;
+
+		bool allocate(FrameArena& ro_Arena, uint32_t v_Capacity) {
+			m_Data = ro_Arena.allocate<T>(v_Capacity);
+			m_Size = 0;
+			m_Capacity = m_Data ? v_Capacity : 0;
+			return m_Data != nullptr;
+		}
+
+		void push_back(const T& ro_Value) {
+			m_Data[m_Size++] = ro_Value;
+		}
+
+		template<typename ...Params>
+		T& emplace_back(Params&&...u_Params) {
+			return *new (m_Data + m_Size++) T(std::forward<Params>(u_Params)...);
+		}
+
+		void resize(uint32_t v_Size, const T& ro_Value) {
+			for (uint32_t i = m_Size; i < v_Size; ++i) new (m_Data + i) T(ro_Value);
+			m_Size = v_Size;
+		}
+
+		void clear() { m_Size = 0; }
+
+		T& operator[](size_t v_Index) { return m_Data[v_Index]; }
+		const T& operator[](size_t v_Index) const { return m_Data[v_Index]; }
+
+		T* begin() { return m_Data; }
+		T* end() { return m_Data + m_Size; }
+		const T* begin() const { return m_Data; }
+		const T* end() const { return m_Data + m_Size; }
+
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+	};
+}
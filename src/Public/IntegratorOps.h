@@ -1,15 +1,15 @@
 #pragma once
+#include "Sampler.h"
 #include "WMath.h"
 
 namespace WavefrontPT::Integrators::Ops {
 	using namespace Math;
 	Math::Vector3 sampleUnfiromUnitSphere(Math::FP32 v_U1, Math::FP32 v_U2);
 
-	uint32_t xorShift32(uint32_t& v_State);
+	Vector3 sampleCosineHemisphere(FP32 u1, FP32 u2);
 
-	inline FP32 randomFloat(uint32_t& state) {
-		uint32_t r = xorShift32(state);
-		return FP32(r) * (1.0f / 4294967296.0f);
+	// Rec. 709 weights
+	inline FP32 luminance(const Vector3& ro_Color) {
+		return 0.2126f * ro_Color.X + 0.7152f * ro_Color.Y + 0.0722f * ro_Color.Z;
 	}
-	Vector3 sampleCosineHemisphere(FP32 u1, FP32 u2);
 }
@@ -1,5 +1,73 @@
 #pragma once
+#include <Core.h>
+
+#include "Sampler.h"
 
 namespace WavefrontPT::Integrator {
-	void basicShadingIntegrator();
+	enum class IntegratorMode : uint32_t {
+		Megakernel, Wavefront, Both
+	};
+
+	// Pass size used under a time budget when no --pass-spp is given, small enough that the
+	// budget is checked every few samples
+	constexpr int BUDGET_DEFAULT_PASS_SAMPLES = 4;
+
+	struct RenderSettings final {
+		size_t m_Width = 1920;
+		size_t m_Height = 1080;
+		int m_SamplesPerPixel = 128;
+		int m_MaxBounces = 8;
+		// Russian roulette from this many bounces on, 0 (the default) traces every path to m_MaxBounces
+		int m_RouletteDepth = 0;
+		IntegratorMode m_Mode = IntegratorMode::Megakernel;
+		// Source of the camera jitter, light and BSDF sample values
+		Integrators::Ops::SamplerType m_Sampler = Integrators::Ops::SamplerType::WhiteNoise;
+		// Wavefront only: reorder rays by origin cell and direction octant before each extension pass
+		bool m_SortRays = false;
+		// Render workers, 0 uses every hardware thread
+		unsigned int m_Threads = 0;
+		// Text scene file, empty renders the built-in demo scene
+		std::string m_ScenePath;
+
+		// Progressive rendering: passes of m_PassSamples spp are accumulated until
+		// m_SamplesPerPixel is reached or the budget runs out. 0 renders everything in one pass
+		int m_PassSamples = 0;
+		// Wall-clock budget in ms, 0 means no limit. Checked between passes only, so with
+		// m_PassSamples at 0 the passes are BUDGET_DEFAULT_PASS_SAMPLES spp
+		double m_TimeBudgetMs = 0.0;
+		// Overwrite the output with the current estimate every K passes, 0 writes only at the end
+		int m_DumpEvery = 0;
+
+		// Relative standard error at which a pixel stops receiving samples, 0 disables adaptive sampling
+		float m_AdaptiveThreshold = 0.0f;
+		// Also write the per-pixel sample counts as a heatmap next to the image
+		bool m_WriteHeatmap = false;
+		// Also write the linear radiance as a float PFM next to the sRGB PPM
+		bool m_WritePfm = false;
+		// Mirror the accumulation state into <output>.ckpt after every pass and resume from it on restart
+		bool m_Checkpoint = false;
+	};
+
+	struct Scene;
+
+	// Totals of one timed render
+	struct RenderMeasurement final {
+		double m_Seconds = 0.0;
+		uint64_t m_Rays = 0;
+		// Paths traced, one camera ray each
+		uint64_t m_Samples = 0;
+		// Segments per path, the camera ray plus every extension ray
+		double m_PathLength = 0.0;
+		unsigned int m_Threads = 0;
+	};
+
+	// Fills ro_Scene with the built-in demo scene, finalizeScene is left to the caller
+	void buildDemoScene(Scene& ro_Scene);
+
+	// Renders m_SamplesPerPixel spp of the finalized ro_Scene in a single pass and times it.
+	// Nothing is printed or written, the image is discarded. Returns false if the buffers could not be allocated
+	bool measureRender(IntegratorMode v_Mode, const RenderSettings& ro_Settings, const Scene& ro_Scene,
+					   RenderMeasurement& ro_Result);
+
+	void basicShadingIntegrator(const RenderSettings& ro_Settings);
 }
@@ -2,10 +2,18 @@
 #include "IntegratorMathCore.h"
 #include "GSphere.h"
 #include "GPlane.h"
+#include "RayPacket.h"
 
 namespace WavefrontPT::Geometry {
 	using namespace Integrator::Math;
 
 	[[nodiscard]] HitRecord hit(const Ray& ro_Ray, const GSphere& ro_Sphere);
 	[[nodiscard]] HitRecord hit(const Ray& ro_Ray, const GPlane& ro_Plane);
+
+	// Any-hit variants for visibility, true when hit() would report a t below v_TMax
+	[[nodiscard]] bool occluded(const Ray& ro_Ray, const GSphere& ro_Sphere, FP32 v_TMax);
+	[[nodiscard]] bool occluded(const Ray& ro_Ray, const GPlane& ro_Plane, FP32 v_TMax);
+
+	// hit(const Ray&, const GPlane&) for every ray of the packet, returns the active lanes that hit with their t in ro_T
+	[[nodiscard]] RegFP32 intersectPlanePacket(const RayPacket& ro_Packet, const GPlane& ro_Plane, RegFP32& ro_T);
 }
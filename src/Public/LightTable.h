@@ -0,0 +1,43 @@
+#pragma once
+#include "GSphere.h"
+#include "IntegratorMathCore.h"
+#include "Material.h"
+
+namespace WavefrontPT::Integrator {
+	struct LightEntry final {
+		Math::ObjectID m_Sphere;
+		Math::Vector3 m_Emission;
+	};
+
+	// Walker alias slot: keep this light with probability m_Threshold, otherwise take m_Alias
+	struct AliasSlot final {
+		Math::FP32 m_Threshold;
+		uint32_t m_Alias;
+	};
+
+	// ----------------------------------------------------------------------------------
+	// Emissive spheres gathered once at finalizeScene, sampled in O(1)
+	// proportionally to emitted power (luminance * surface area)
+	// ----------------------------------------------------------------------------------
+	struct LightTable final {
+		std::vector<LightEntry> m_Lights;
+		std::vector<Math::FP32> m_Pmf;
+		std::vector<AliasSlot> m_Alias;
+		Math::FP32 m_TotalPower = 0.0f;
+
+		LightTable() = default;
+
+		LightTable(const LightTable&) = default;
+		LightTable& operator=(const LightTable&) = default;
+		LightTable(LightTable&&) noexcept = default;
+		LightTable& operator=(LightTable&&) noexcept = default;
+		~LightTable() = default;
+
+		bool isEmpty() const { return m_Lights.empty(); }
+	};
+
+	LightTable buildLightTable(const Geometry::GSphere* p_Spheres, size_t v_SphereCount, const Materials::Material* p_Materials);
+
+	// v_U in [0, 1), returns the light index and writes its selection probability
+	uint32_t sampleLight(const LightTable& ro_Table, Math::FP32 v_U, Math::FP32& ro_Pdf);
+}
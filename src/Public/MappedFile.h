@@ -0,0 +1,43 @@
+#pragma once
+#include <Core.h>
+
+namespace WavefrontPT::Memory {
+	// ----------------------------------------------------------------------------------
+	// A whole file mapped into the address space. Writable mappings are shared, stores
+	// land in the page cache and reach the file without an explicit write call.
+	// ----------------------------------------------------------------------------------
+	class MappedFile final {
+		std::byte* m_Data = nullptr;
+		size_t m_Size = 0;
+#if defined(_WIN32)
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#else
+		int m_File = -1;
+#endif
+
+	public:
+		MappedFile() = default;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& u_Other) noexcept;
+		MappedFile& operator=(MappedFile&& u_Other) noexcept;
+		~MappedFile();
+
+		// Creates or truncates p_Path to exactly v_Bytes and maps it read/write
+		bool create(const char* p_Path, size_t v_Bytes);
+		// Maps an existing file, read-only unless v_Writable
+		bool open(const char* p_Path, bool v_Writable = false);
+		// Writes back dirty pages in [v_Offset, v_Offset + v_Bytes), v_Offset must be page aligned.
+		// v_Wait blocks until they reach the disk, otherwise writeback is only scheduled
+		bool flush(size_t v_Offset, size_t v_Bytes, bool v_Wait);
+		bool flush() { return flush(0, m_Size, false); }
+		void close();
+
+		std::byte* data() { return m_Data; }
+		const std::byte* data() const { return m_Data; }
+		size_t size() const { return m_Size; }
+		bool isOpen() const { return m_Data != nullptr; }
+	};
+}
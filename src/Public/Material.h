@@ -22,4 +22,18 @@ namespace WavefrontPT::Materials {
 
 		~Material() = default;
 	};
+
+	// Shading kernels are specialized per class, hits are bucketed by it before shading
+	enum class MaterialClass : uint32_t {
+		Emissive, Diffuse, Metal
+	};
+
+	constexpr uint32_t MATERIAL_CLASS_COUNT = 3;
+
+	// Any emission makes an emitter, which ends the path. Otherwise metalness above one half picks the metal lobe
+	inline MaterialClass classify(const Material& ro_Mat) {
+		if (Math::maxFast(ro_Mat.m_Emission.X, Math::maxFast(ro_Mat.m_Emission.Y, ro_Mat.m_Emission.Z)) > 0.0f)
+			return MaterialClass::Emissive;
+		return ro_Mat.m_Metalness > 0.5f ? MaterialClass::Metal : MaterialClass::Diffuse;
+	}
 }
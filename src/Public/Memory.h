@@ -1,11 +1,12 @@
 #pragma once
 
 namespace WavefrontPT::Memory {
-	enum class MemoryOperation final : uint32_t {
+	enum class MemoryOperation : uint32_t {
 		Reserve, Commit, Release, Free
 	};
 
 	static constexpr size_t PAGE_FILE = 4096;
+	static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
 
 	constexpr size_t alignToPage(size_t v_Size) {
 		return (v_Size + PAGE_FILE - 1) & ~(PAGE_FILE - 1);
@@ -13,4 +14,7 @@ namespace WavefrontPT::Memory {
 
 	void* alloc(void* p_Memory, size_t v_Bytes, MemoryOperation v_Ops);
 	bool free(void* p_Memory, size_t v_Bytes, MemoryOperation v_Ops);
+
+	// Opt-in transparent huge pages for a reserved range, a hint only (MADV_HUGEPAGE on Linux)
+	bool adviseHugePages(void* p_Memory, size_t v_Bytes);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <Memory.h>
 #include <Allocator.h>
+#include <utility>
 
 namespace WavefrontPT::Memory {
 	// High performance iterative arena allocator
@@ -19,13 +20,27 @@ namespace WavefrontPT::Memory {
 		ArenaWalker(const ArenaWalker&) = delete;
 		ArenaWalker& operator=(const ArenaWalker&) = delete;
 
-		ArenaWalker(ArenaWalker&&) noexcept = default;
-		ArenaWalker& operator=(ArenaWalker&&) noexcept = default;
+		ArenaWalker(ArenaWalker&& ro_Other) noexcept
+			: m_BaseAllocation(std::exchange(ro_Other.m_BaseAllocation, nullptr)),
+			m_AllocationEnd(std::exchange(ro_Other.m_AllocationEnd, nullptr)),
+			m_PtrHead(std::exchange(ro_Other.m_PtrHead, nullptr)),
+			m_TotalSize(std::exchange(ro_Other.m_TotalSize, 0)) {}
 
+		ArenaWalker& operator=(ArenaWalker&& ro_Other) noexcept {
+			if (this == &ro_Other) return *this;
+			release();
+			m_BaseAllocation = std::exchange(ro_Other.m_BaseAllocation, nullptr);
+			m_AllocationEnd = std::exchange(ro_Other.m_AllocationEnd, nullptr);
+			m_PtrHead = std::exchange(ro_Other.m_PtrHead, nullptr);
+			m_TotalSize = std::exchange(ro_Other.m_TotalSize, 0);
+			return *this;
+		}
+
+		// v_PageSize is in bytes, rounded up to whole pages
 		T* reserve(size_t v_PageSize) {
 			if (m_BaseAllocation) return m_BaseAllocation;
 			size_t aligned = alignToPage(v_PageSize);
-			m_BaseAllocation = alloc(nullptr, aligned, MemoryOperation::Reserve);
+			m_BaseAllocation = static_cast<T*>(alloc(nullptr, aligned, MemoryOperation::Reserve));
 			if (!m_BaseAllocation)	return nullptr;
 			m_PtrHead = m_BaseAllocation;
 			uintptr_t advanceLimit = reinterpret_cast<uintptr_t>(m_BaseAllocation) + aligned;
@@ -34,9 +49,10 @@ namespace WavefrontPT::Memory {
 			return m_BaseAllocation;
 		}
 
+		// v_Count is in elements, rounded up to whole pages
 		T* commitForward(size_t v_Count) {
 			if (!m_BaseAllocation) return nullptr;
-			size_t aligned = alignToPage(v_Count);
+			size_t aligned = alignToPage(v_Count * sizeof(T));
 			uintptr_t head = reinterpret_cast<uintptr_t>(m_PtrHead);
 			uintptr_t newHead = head + aligned;
 			if (newHead > reinterpret_cast<uintptr_t>(m_AllocationEnd))return nullptr;
@@ -47,21 +63,22 @@ namespace WavefrontPT::Memory {
 			return blockStart;
 		}
 
+		// v_Count is in elements, rounded up to whole pages
 		bool decommit(size_t v_Count) {
 			if (!m_BaseAllocation) return false;
-			size_t aligned = alignToPage(v_Count);
+			size_t aligned = alignToPage(v_Count * sizeof(T));
 			uintptr_t base = reinterpret_cast<uintptr_t>(m_BaseAllocation);
 			uintptr_t head = reinterpret_cast<uintptr_t>(m_PtrHead);
 			if (aligned > (head - base)) return false;
 			uintptr_t newHead = head - aligned;
-			if (!alloc(reinterpret_cast<T*>(newHead), aligned, MemoryOperation::Free))return false;
+			if (!free(reinterpret_cast<T*>(newHead), aligned, MemoryOperation::Free))return false;
 			m_PtrHead = reinterpret_cast<T*>(newHead);
 			return true;
 		}
 
 		bool release() {
 			if (!m_BaseAllocation) return true;
-			bool result = alloc(m_BaseAllocation, 0, MemoryOperation::Release);
+			bool result = free(m_BaseAllocation, m_TotalSize, MemoryOperation::Release);
 			m_BaseAllocation = nullptr;
 			m_AllocationEnd = nullptr;
 			m_PtrHead = nullptr;
@@ -74,5 +91,18 @@ namespace WavefrontPT::Memory {
 			new (p_Memory) T(std::forward<Params>(u_Params)...);
 			return p_Memory + 1;
 		}
+
+		// Call after reserve, before the pages are first touched
+		bool adviseHugePages() {
+			return Memory::adviseHugePages(m_BaseAllocation, m_TotalSize);
+		}
+
+		T* data() const { return m_BaseAllocation; }
+
+		size_t committedCount() const {
+			return (reinterpret_cast<uintptr_t>(m_PtrHead) - reinterpret_cast<uintptr_t>(m_BaseAllocation)) / sizeof(T);
+		}
+
+		size_t reservedCount() const { return m_TotalSize / sizeof(T); }
 	};
 }
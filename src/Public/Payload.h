@@ -1,6 +1,7 @@
 #pragma once
 #include "IntegratorMathCore.h"
 #include "Material.h"
+#include "Sampler.h"
 #include "Scene.h"
 #include "WMath.h"
 
@@ -9,12 +10,12 @@ namespace WavefrontPT::Integrator {
 		Math::Vector3 m_Radiance;
 		Math::Vector3 m_Throughput;
 		Math::Ray m_CurrentRay;
-		uint32_t m_RngState;
+		Integrators::Ops::PathSampler m_Sampler;
 
 		explicit Payload(const Math::Ray& ro_Ray)
 			: m_Radiance(0.0f, 0.0f, 0.0f),
 			m_Throughput(1.0f, 1.0f, 1.0f),
-			m_CurrentRay(ro_Ray), m_RngState() {}
+			m_CurrentRay(ro_Ray), m_Sampler() {}
 
 		Payload(const Payload&) = default;
 		Payload& operator=(const Payload&) = default;
@@ -24,5 +25,65 @@ namespace WavefrontPT::Integrator {
 		~Payload() = default;
 	};												  
 
+	// Deferred NEE connection, m_Contribution is already weighted by path throughput
+	struct ShadowRay final {
+		Math::Ray m_Ray;
+		Math::Vector3 m_Contribution;
+		Math::FP32 m_TMax;
+		uint32_t m_PathIndex;
+
+		ShadowRay() : m_Ray(Math::Point3(), Math::Vector3()), m_Contribution(0.0f), m_TMax(0.0f), m_PathIndex(0) {}
+
+		ShadowRay(const ShadowRay&) = default;
+		ShadowRay& operator=(const ShadowRay&) = default;
+		ShadowRay(ShadowRay&&) noexcept = default;
+		ShadowRay& operator=(ShadowRay&&) noexcept = default;
+
+		~ShadowRay() = default;
+	};
+
 	void evaluateMaterialResponse(const Scene& ro_Scene, Payload& ro_Payload,const Math::HitRecord& ro_Hit,const Materials::Material& ro_Mat);
+
+	// ----------------------------------------------------------------------------------
+	// Split stages of evaluateMaterialResponse, shared with the wavefront integrator.
+	// evaluateMaterialResponse dispatches once on classify(), then runs
+	//   Emissive:        shadeEmission
+	//   Diffuse, Metal:  sampleDirectLight<C> -> traceShadowRay -> sampleBounce<C>
+	// The surface stages are specialized per class and never re-test the material.
+	// ----------------------------------------------------------------------------------
+
+	// Constant sky, terminates the path
+	void shadeMiss(Payload& ro_Payload);
+
+	// Adds the emitter's radiance and terminates the path, ro_Mat must be MaterialClass::Emissive
+	void shadeEmission(Payload& ro_Payload, const Materials::Material& ro_Mat);
+
+	// Picks one light from the scene's alias table and samples a point on it, the selection
+	// probability is folded into the contribution. Requires a non-empty light table.
+	// Returns true if a shadow ray must be traced, ro_Shadow.m_PathIndex is left to the caller
+	template<Materials::MaterialClass Class>
+	bool sampleDirectLight(const Scene& ro_Scene, Payload& ro_Payload, const Math::HitRecord& ro_Hit,
+						   const Materials::Material& ro_Mat, ShadowRay& ro_Shadow);
+
+	// Returns true if the light sample is visible
+	bool traceShadowRay(const Scene& ro_Scene, const ShadowRay& ro_Shadow);
+
+	template<Materials::MaterialClass Class>
+	void sampleBounce(Payload& ro_Payload, const Math::HitRecord& ro_Hit, const Materials::Material& ro_Mat);
+
+	// Whether Russian roulette follows the shading of v_Bounce: from bounce v_MinDepth - 1 on,
+	// 0 disables it. The last bounce is left out, its path ends there anyway
+	inline bool rouletteAfter(int v_Bounce, int v_MinDepth, int v_MaxBounce) {
+		return v_MinDepth > 0 && v_Bounce + 1 >= v_MinDepth && v_Bounce + 1 < v_MaxBounce;
+	}
+
+	// Unbiased Russian roulette: the path survives with probability q = min(1, max throughput
+	// component) and its throughput is divided by q. Always draws one dimension.
+	// Returns false if the path was terminated, its throughput is then zero
+	bool surviveRoulette(Payload& ro_Payload);
+
+	// sampleBounce<Metal> for up to 8 hits at once through the Stripe3 GGX sampler.
+	// Same distribution as the scalar form, rounding differs in the last bits
+	void sampleMetalBounces(Payload* const* pp_Paths, const Math::HitRecord* const* pp_Hits,
+							const Materials::Material* const* pp_Mats, uint32_t v_Count);
 }
@@ -1,28 +1,107 @@
 #pragma once
 #include "MemoryAllocators.h"
 
+#include <atomic>
+#include <bit>
+#include <type_traits>
+
 namespace WavefrontPT::Threading {
+	// ----------------------------------------------------------------------------------
+	// Fixed capacity Chase-Lev work-stealing deque, memory orders after Le et al. 2013.
+	// The owning thread pushes and pops at the bottom, any other thread steals from
+	// the top. Slots go through atomic_ref so a thief reading a slot the owner is
+	// overwriting is not a data race, the losing side simply fails its CAS.
+	// ----------------------------------------------------------------------------------
 	template<typename T, typename A = Memory::ArenaWalker<T>, size_t AllocationSize = 4096>
 	class ChaseLevQueue final {
+		static_assert(std::is_trivially_copyable_v<T>, "ChaseLevQueue slots are copied with atomic loads and stores");
+
 		using type_ = T;
 		using allocator_ = A;
 
 		allocator_  m_Allocator;
 
-		std::atomic<size_t> m_Top;
-		std::atomic<size_t> m_Bottom;
+		// Thieves hammer m_Top, the owner m_Bottom, keep them on separate lines
+		alignas(64) std::atomic<int64_t> m_Top;
+		alignas(64) std::atomic<int64_t> m_Bottom;
 
 		size_t m_Capacity;
 		size_t m_Mask;
 
-		const T* m_UnderlyingBuffer;
+		T* m_UnderlyingBuffer;
 
 	public:
-		ChaseLevQueue() : m_Top(0), m_Bottom(0),
-			m_Capacity(64), m_Mask(0), m_UnderlyingBuffer(m_Allocator.reserve(4096 * 1024)) {
+		// v_Capacity is in elements, rounded up to a power of two
+		explicit ChaseLevQueue(size_t v_Capacity = AllocationSize) : m_Top(0), m_Bottom(0),
+			m_Capacity(std::bit_ceil(std::max<size_t>(v_Capacity, 1))), m_Mask(m_Capacity - 1), m_UnderlyingBuffer(nullptr) {
+			if (m_Allocator.reserve(m_Capacity * sizeof(T)))
+				m_UnderlyingBuffer = m_Allocator.commitForward(m_Capacity);
 		}
 		~ChaseLevQueue() {
 			m_Allocator.release();
 		}
+
+		ChaseLevQueue(const ChaseLevQueue&) = delete;
+		ChaseLevQueue& operator=(const ChaseLevQueue&) = delete;
+		ChaseLevQueue(ChaseLevQueue&&) = delete;
+		ChaseLevQueue& operator=(ChaseLevQueue&&) = delete;
+
+		bool isValid() const { return m_UnderlyingBuffer != nullptr; }
+		size_t capacity() const { return m_Capacity; }
+
+		// Racy snapshot, only good for heuristics
+		size_t sizeApprox() const {
+			const int64_t size = m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed);
+			return size > 0 ? size_t(size) : 0;
+		}
+
+		// Owner only, false when full
+		bool push(const T& ro_Value) {
+			const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			const int64_t top = m_Top.load(std::memory_order_acquire);
+			if (bottom - top >= int64_t(m_Capacity)) return false;
+
+			std::atomic_ref<T>(m_UnderlyingBuffer[size_t(bottom) & m_Mask]).store(ro_Value, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Owner only, LIFO end
+		bool pop(T& ro_Out) {
+			const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom) {
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			ro_Out = std::atomic_ref<T>(m_UnderlyingBuffer[size_t(bottom) & m_Mask]).load(std::memory_order_relaxed);
+			if (top != bottom) return true;
+
+			// Last element, race the thieves for it
+			const bool won = m_Top.compare_exchange_strong(top, top + 1,
+														   std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		// Any thread, FIFO end. False when empty or when another thread won the race
+		bool steal(T& ro_Out) {
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+			if (top >= bottom) return false;
+
+			const T value = std::atomic_ref<T>(m_UnderlyingBuffer[size_t(top) & m_Mask]).load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return false;
+
+			ro_Out = value;
+			return true;
+		}
 	};
 }
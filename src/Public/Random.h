@@ -0,0 +1,61 @@
+#pragma once
+#include "WMath.h"
+
+namespace WavefrontPT::Integrators::Ops {
+	using namespace Math;
+
+	// ----------------------------------------------------------------------------------
+	// Counter-based hashing: draw d of a stream is hash(key, d), so every (pixel,
+	// sample, dimension) is addressed directly and no state is carried between draws.
+	// Keys come from hashing pixel and sample together, which keeps neighbouring
+	// pixels and samples on unrelated sequences.
+	// The 8-lane forms run the same 32-bit integer ops per lane and are bit-identical
+	// to the scalar forms.
+	// ----------------------------------------------------------------------------------
+	constexpr uint32_t RNG_DIMENSION_STEP = 0x9E3779B9u;
+	constexpr uint32_t RNG_SAMPLE_SALT = 0x3C6EF372u;
+
+	// Low-bias 32-bit finalizer (xorshift-multiply, two rounds)
+	inline uint32_t mixBits(uint32_t v_Value) {
+		v_Value ^= v_Value >> 16;
+		v_Value *= 0x7FEB352Du;
+		v_Value ^= v_Value >> 15;
+		v_Value *= 0x846CA68Bu;
+		v_Value ^= v_Value >> 16;
+		return v_Value;
+	}
+
+	inline __m256i mixBits(__m256i v_Value) {
+		v_Value = _mm256_xor_si256(v_Value, _mm256_srli_epi32(v_Value, 16));
+		v_Value = _mm256_mullo_epi32(v_Value, _mm256_set1_epi32(int(0x7FEB352Du)));
+		v_Value = _mm256_xor_si256(v_Value, _mm256_srli_epi32(v_Value, 15));
+		v_Value = _mm256_mullo_epi32(v_Value, _mm256_set1_epi32(int(0x846CA68Bu)));
+		v_Value = _mm256_xor_si256(v_Value, _mm256_srli_epi32(v_Value, 16));
+		return v_Value;
+	}
+
+	inline uint32_t streamKey(uint32_t v_Pixel, uint32_t v_Sample) {
+		return mixBits(v_Pixel ^ mixBits(v_Sample ^ RNG_SAMPLE_SALT));
+	}
+
+	inline __m256i streamKey(__m256i v_Pixel, __m256i v_Sample) {
+		return mixBits(_mm256_xor_si256(v_Pixel, mixBits(_mm256_xor_si256(v_Sample, _mm256_set1_epi32(int(RNG_SAMPLE_SALT))))));
+	}
+
+	inline uint32_t hashRandom(uint32_t v_Key, uint32_t v_Dimension) {
+		return mixBits(v_Key + v_Dimension * RNG_DIMENSION_STEP);
+	}
+
+	inline __m256i hashRandom(__m256i v_Key, __m256i v_Dimension) {
+		return mixBits(_mm256_add_epi32(v_Key, _mm256_mullo_epi32(v_Dimension, _mm256_set1_epi32(int(RNG_DIMENSION_STEP)))));
+	}
+
+	// Top 24 bits, exactly representable, so [0, 1) is never rounded up to 1
+	inline Math::FP32 toUnitFloat(uint32_t v_Bits) {
+		return Math::FP32(v_Bits >> 8) * (1.0f / 16777216.0f);
+	}
+
+	inline Math::Reg8 toUnitFloat(__m256i v_Bits) {
+		return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(v_Bits, 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "IntegratorMathCore.h"
+
+namespace WavefrontPT::Integrator::Math {
+	constexpr uint32_t RAY_PACKET_WIDTH = 8;
+	constexpr uint32_t RAY_PACKET_FULL_MASK = (1u << RAY_PACKET_WIDTH) - 1;
+
+	// ----------------------------------------------------------------------------------
+	// 8 rays traced together, lane i of every register is ray i. Lanes whose m_Active
+	// bits are clear are carried along but never reported as hits.
+	// ----------------------------------------------------------------------------------
+	struct alignas(32) RayPacket final {
+		Stripe3 m_Origin;
+		Stripe3 m_Direction;
+		RegFP32 m_Active;
+
+		RayPacket() : m_Active(_mm256_setzero_ps()) {}
+
+		RayPacket(const RayPacket&) = default;
+		RayPacket& operator=(const RayPacket&) = default;
+		RayPacket(RayPacket&&) noexcept = default;
+		RayPacket& operator=(RayPacket&&) noexcept = default;
+		~RayPacket() = default;
+
+		uint32_t activeMask() const { return static_cast<uint32_t>(_mm256_movemask_ps(m_Active)); }
+	};
+
+	// ----------------------------------------------------------------------------------
+	// Per-lane closest hits of a RayPacket in SoA form. Lanes outside m_HitMask hold a
+	// miss: t = MISS and invalid ids.
+	// ----------------------------------------------------------------------------------
+	struct alignas(32) PacketHit final {
+		FP32 m_T[RAY_PACKET_WIDTH];
+		FP32 m_NormalX[RAY_PACKET_WIDTH];
+		FP32 m_NormalY[RAY_PACKET_WIDTH];
+		FP32 m_NormalZ[RAY_PACKET_WIDTH];
+		FP32 m_PointX[RAY_PACKET_WIDTH];
+		FP32 m_PointY[RAY_PACKET_WIDTH];
+		FP32 m_PointZ[RAY_PACKET_WIDTH];
+		MaterialID m_MatID[RAY_PACKET_WIDTH];
+		ObjectID m_ObjID[RAY_PACKET_WIDTH];
+		uint32_t m_HitMask;
+	};
+
+	// All-ones float lanes for the set bits of v_Bits
+	inline RegFP32 laneMask(uint32_t v_Bits) {
+		const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+		return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(int(v_Bits)), bits), bits));
+	}
+
+	Ray laneRay(const RayPacket& ro_Packet, uint32_t v_Lane);
+	HitRecord laneHit(const PacketHit& ro_Hit, uint32_t v_Lane);
+
+	void clearPacketHit(PacketHit& ro_Hit);
+	void setLaneHit(PacketHit& ro_Hit, uint32_t v_Lane, const HitRecord& ro_Record);
+}
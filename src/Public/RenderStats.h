@@ -0,0 +1,199 @@
+#pragma once
+#include <Core.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Per-stage profiling, set through the WAVEFRONT_PROFILE CMake option. At 0 every
+// WF_PROFILE_* hook expands to nothing and the counters stay zero
+#ifndef WF_PROFILE
+#define WF_PROFILE 0
+#endif
+
+namespace WavefrontPT::Integrator {
+	constexpr bool PROFILE_ENABLED = WF_PROFILE != 0;
+
+	// Time-stamp counter. GCC and Clang go through the builtin, the intrinsic headers may
+	// already have been pulled into a namespace by WMath.h
+	inline uint64_t readCycleCounter() {
+#if defined(_MSC_VER)
+		return __rdtsc();
+#else
+		return __builtin_ia32_rdtsc();
+#endif
+	}
+
+	// Stages that cycles are charged to, Other covers scheduling, ray sorting and accumulation
+	enum class ProfileStage : uint32_t {
+		Other, Camera, Extension, Shading, Shadow
+	};
+	constexpr uint32_t PROFILE_STAGE_COUNT = 5;
+
+	// ----------------------------------------------------------------------------------
+	// Event counts and stage cycles of one worker. Traversal counts the single-ray walks
+	// of extension and shadow rays, packet traversal the 8-lane camera walk, where one
+	// test covers every live lane of the packet.
+	// Stage time is exclusive: entering a stage charges the cycles since the last switch
+	// to the stage being left, so a shadow ray traced from inside shading counts as Shadow.
+	// ----------------------------------------------------------------------------------
+	struct ProfileCounters final {
+		uint64_t m_NodeTests = 0;
+		uint64_t m_SphereBlockTests = 0;
+		uint64_t m_PlaneTests = 0;
+		uint64_t m_PacketNodeTests = 0;
+		uint64_t m_PacketSphereBlockTests = 0;
+		uint64_t m_PacketPlaneTests = 0;
+		// Closest-hit queries by outcome, one per ray including camera lanes, and shadow
+		// rays that found a blocker
+		uint64_t m_ClosestHits = 0;
+		uint64_t m_ClosestMisses = 0;
+		uint64_t m_ShadowOccluded = 0;
+		// Path terminations, Russian roulette is counted by RayCounters::m_RouletteTerminations
+		uint64_t m_TerminatedMiss = 0;
+		uint64_t m_TerminatedEmission = 0;
+		uint64_t m_TerminatedThroughput = 0;
+		uint64_t m_TerminatedMaxBounce = 0;
+		uint64_t m_StageCycles[PROFILE_STAGE_COUNT] = {};
+
+		ProfileStage m_Stage = ProfileStage::Other;
+		uint64_t m_StageStart = 0;
+
+		// Charges the cycles since the last switch to the current stage, then enters v_Stage
+		void switchStage(ProfileStage v_Stage) {
+			const uint64_t now = readCycleCounter();
+			m_StageCycles[static_cast<uint32_t>(m_Stage)] += now - m_StageStart;
+			m_StageStart = now;
+			m_Stage = v_Stage;
+		}
+
+		uint64_t totalCycles() const {
+			uint64_t total = 0;
+			for (uint64_t cycles : m_StageCycles)
+				total += cycles;
+			return total;
+		}
+
+		// Stage bookkeeping is per worker and not merged
+		ProfileCounters& operator+=(const ProfileCounters& ro_Other) {
+			m_NodeTests += ro_Other.m_NodeTests;
+			m_SphereBlockTests += ro_Other.m_SphereBlockTests;
+			m_PlaneTests += ro_Other.m_PlaneTests;
+			m_PacketNodeTests += ro_Other.m_PacketNodeTests;
+			m_PacketSphereBlockTests += ro_Other.m_PacketSphereBlockTests;
+			m_PacketPlaneTests += ro_Other.m_PacketPlaneTests;
+			m_ClosestHits += ro_Other.m_ClosestHits;
+			m_ClosestMisses += ro_Other.m_ClosestMisses;
+			m_ShadowOccluded += ro_Other.m_ShadowOccluded;
+			m_TerminatedMiss += ro_Other.m_TerminatedMiss;
+			m_TerminatedEmission += ro_Other.m_TerminatedEmission;
+			m_TerminatedThroughput += ro_Other.m_TerminatedThroughput;
+			m_TerminatedMaxBounce += ro_Other.m_TerminatedMaxBounce;
+			for (uint32_t s = 0; s < PROFILE_STAGE_COUNT; ++s)
+				m_StageCycles[s] += ro_Other.m_StageCycles[s];
+			return *this;
+		}
+	};
+
+	struct RayCounters final {
+		uint64_t m_CameraRays = 0;
+		uint64_t m_ExtensionRays = 0;
+		uint64_t m_ShadowRays = 0;
+		// Camera rays are traced in packets, m_CameraRays / m_CameraPackets is their lane occupancy
+		uint64_t m_CameraPackets = 0;
+		// Wavefront extension pass: wall time, and hardware cache misses over the rays
+		// traced while the thread's CacheMissCounter was open
+		uint64_t m_ExtensionNs = 0;
+		uint64_t m_ExtensionCacheMisses = 0;
+		uint64_t m_CountedExtensionRays = 0;
+		uint64_t m_SortNs = 0;
+		uint64_t m_SortedRays = 0;
+		uint64_t m_RouletteTerminations = 0;
+		ProfileCounters m_Profile;
+
+		uint64_t total() const {
+			return m_CameraRays + m_ExtensionRays + m_ShadowRays;
+		}
+
+		RayCounters& operator+=(const RayCounters& ro_Other) {
+			m_CameraRays += ro_Other.m_CameraRays;
+			m_ExtensionRays += ro_Other.m_ExtensionRays;
+			m_ShadowRays += ro_Other.m_ShadowRays;
+			m_CameraPackets += ro_Other.m_CameraPackets;
+			m_ExtensionNs += ro_Other.m_ExtensionNs;
+			m_ExtensionCacheMisses += ro_Other.m_ExtensionCacheMisses;
+			m_CountedExtensionRays += ro_Other.m_CountedExtensionRays;
+			m_SortNs += ro_Other.m_SortNs;
+			m_SortedRays += ro_Other.m_SortedRays;
+			m_RouletteTerminations += ro_Other.m_RouletteTerminations;
+			m_Profile += ro_Other.m_Profile;
+			return *this;
+		}
+	};
+
+	// Each worker resets its copy on start and hands it back on exit
+	inline thread_local RayCounters t_RayCounters;
+
+	// Charges the enclosing block to v_Stage and returns to the outer stage on exit
+	class ProfileScope final {
+		ProfileStage m_Outer;
+
+	public:
+		explicit ProfileScope(ProfileStage v_Stage) : m_Outer(t_RayCounters.m_Profile.m_Stage) {
+			t_RayCounters.m_Profile.switchStage(v_Stage);
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+		ProfileScope(ProfileScope&&) = delete;
+		ProfileScope& operator=(ProfileScope&&) = delete;
+
+		~ProfileScope() {
+			t_RayCounters.m_Profile.switchStage(m_Outer);
+		}
+	};
+
+	// Writes <v_BaseName>_profile.json and <v_BaseName>_profile.csv with the merged counters of
+	// one render. Returns false if either file could not be written
+	bool writeProfileReport(const std::string& ro_BaseName, const char* p_Mode, const RayCounters& ro_Total, double v_Seconds);
+
+	// ----------------------------------------------------------------------------------
+	// User-space hardware cache-miss counter of the calling thread. Opening fails quietly
+	// where the OS exposes no counters (not Linux, containers, perf_event_paranoid),
+	// isOpen() then stays false and read() returns 0.
+	// ----------------------------------------------------------------------------------
+	class CacheMissCounter final {
+		int m_Fd = -1;
+		bool m_Tried = false;
+
+	public:
+		CacheMissCounter() = default;
+
+		CacheMissCounter(const CacheMissCounter&) = delete;
+		CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+		CacheMissCounter(CacheMissCounter&&) = delete;
+		CacheMissCounter& operator=(CacheMissCounter&&) = delete;
+		~CacheMissCounter();
+
+		// Only the first call reaches the OS, later ones report the outcome of that attempt
+		bool open();
+		bool isOpen() const { return m_Fd >= 0; }
+		uint64_t read() const;
+	};
+
+	inline thread_local CacheMissCounter t_CacheMisses;
+}
+
+#if WF_PROFILE
+#define WF_PROFILE_COUNT(Counter, Amount) (::WavefrontPT::Integrator::t_RayCounters.m_Profile.Counter += (Amount))
+#define WF_PROFILE_SCOPE(Stage) \
+	const ::WavefrontPT::Integrator::ProfileScope profileScope(::WavefrontPT::Integrator::ProfileStage::Stage)
+// Worker start and exit, brackets everything a worker charges to its stages
+#define WF_PROFILE_BEGIN() (::WavefrontPT::Integrator::t_RayCounters.m_Profile.m_StageStart = ::WavefrontPT::Integrator::readCycleCounter())
+#define WF_PROFILE_END() (::WavefrontPT::Integrator::t_RayCounters.m_Profile.switchStage(::WavefrontPT::Integrator::ProfileStage::Other))
+#else
+#define WF_PROFILE_COUNT(Counter, Amount) ((void)0)
+#define WF_PROFILE_SCOPE(Stage) ((void)0)
+#define WF_PROFILE_BEGIN() ((void)0)
+#define WF_PROFILE_END() ((void)0)
+#endif
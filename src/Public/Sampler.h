@@ -0,0 +1,45 @@
+#pragma once
+#include "Random.h"
+
+namespace WavefrontPT::Integrators::Ops {
+	enum class SamplerType : uint32_t {
+		WhiteNoise, Sobol
+	};
+
+	// ----------------------------------------------------------------------------------
+	// Sample source of one path: value d of the path through (pixel, sample) is a pure
+	// function of (pixel, sample, d), so both integrators and every thread see the same
+	// numbers regardless of order. m_Dimension counts the draws made so far.
+	// WhiteNoise hashes the three together. Sobol takes the sample's point of a 4D Sobol
+	// sequence per group of 4 dimensions, with the index shuffled and the point
+	// Owen-scrambled per pixel and group, so each pixel gets its own decorrelated
+	// low-discrepancy sequence.
+	// 2D draws start on an even dimension, which keeps both coordinates inside one
+	// Sobol group where the pair is stratified jointly.
+	// ----------------------------------------------------------------------------------
+	struct PathSampler final {
+		// WhiteNoise: streamKey(pixel, sample), Sobol: per-pixel scramble seed
+		uint32_t m_Key = 0;
+		// Sample index, bit-reversed for Sobol
+		uint32_t m_Index = 0;
+		uint32_t m_Dimension = 0;
+		SamplerType m_Type = SamplerType::WhiteNoise;
+	};
+
+	// 8 paths drawing the same dimension, lane i is path i
+	struct alignas(32) PathSampler8 final {
+		__m256i m_Key;
+		__m256i m_Index;
+		uint32_t m_Dimension;
+		SamplerType m_Type;
+	};
+
+	constexpr uint32_t SOBOL_DIMENSIONS = 4;
+
+	PathSampler makePathSampler(SamplerType v_Type, uint32_t v_Pixel, uint32_t v_Sample, uint32_t v_Dimension);
+	PathSampler8 makePathSampler8(SamplerType v_Type, __m256i v_Pixel, __m256i v_Sample, uint32_t v_Dimension);
+
+	Math::FP32 sample1D(PathSampler& ro_Sampler);
+	void sample2D(PathSampler& ro_Sampler, Math::FP32& ro_U1, Math::FP32& ro_U2);
+	void sample2D(PathSampler8& ro_Sampler, Math::Reg8& ro_U1, Math::Reg8& ro_U2);
+}
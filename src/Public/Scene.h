@@ -1,23 +1,51 @@
 #pragma once
+#include "BVH.h"
+#include "Camera.h"
 #include "IntegratorMathCore.h"
+#include "LightTable.h"
+#include "MappedFile.h"
 #include "Material.h"
+#include "MemoryAllocators.h"
+#include "RayPacket.h"
+#include "WideBVH.h"
 #include "GPlane.h"
 #include "GSphere.h"
 
 namespace WavefrontPT::Integrator {
-	constexpr size_t MAX_COUNT = 20;
+	// Address space reserved per array, pages are committed as objects are added
+	constexpr size_t SCENE_MAX_MATERIALS = 1 << 20;
+	constexpr size_t SCENE_MAX_SPHERES = 1 << 24;
+	constexpr size_t SCENE_MAX_PLANES = 1 << 22;
+	// Elements committed per arena growth step
+	constexpr size_t SCENE_COMMIT_CHUNK = 4096;
+
+	// ----------------------------------------------------------------------------------
+	// Scene arrays either live in the owned arenas (built through register/add*) or point
+	// straight into a mapped scene cache, in which case the scene is read-only and add*
+	// refuses new objects.
+	// ----------------------------------------------------------------------------------
 	struct Scene final {
-		Materials::Material m_Materials[MAX_COUNT] = {};
-		Geometry::GSphere m_Spheres[MAX_COUNT] = {};
-		Geometry::GPlane m_Planes[MAX_COUNT] = {};
+		Memory::ArenaWalker<Materials::Material> m_MaterialArena;
+		Memory::ArenaWalker<Geometry::GSphere> m_SphereArena;
+		Memory::ArenaWalker<Geometry::GPlane> m_PlaneArena;
+		Memory::MappedFile m_Cache;
+
+		Materials::Material* m_Materials = nullptr;
+		Geometry::GSphere* m_Spheres = nullptr;
+		Geometry::GPlane* m_Planes = nullptr;
 		Math::MaterialID m_MaterialCount;
 		Math::ObjectID m_SphereCount;
 		Math::ObjectID m_PlaneCount;
+		CameraDesc m_Camera;
+
+		Geometry::BVH m_BVH;
+		Geometry::BVH8 m_WideBVH;
+		LightTable m_Lights;
 
 		Scene() : m_MaterialCount(0), m_SphereCount(0), m_PlaneCount(0) {}
 
-		Scene(const Scene&) = default;
-		Scene& operator=(const Scene&) = default;
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
 		Scene(Scene&&) noexcept = default;
 		Scene& operator=(Scene&&) noexcept = default;
 		~Scene() = default;
@@ -26,5 +54,12 @@ namespace WavefrontPT::Integrator {
 	Math::MaterialID registerMaterial(Scene& ro_Scene, const Materials::Material& ro_Mat);
 	Math::ObjectID addSphere(Scene& ro_Scene, const Geometry::GSphere& ro_Sphere);
 	Math::ObjectID addPlane(Scene& ro_Scene, const Geometry::GPlane& ro_Plane);
+	// Builds the binary BVH, collapses it into the 8-wide BVH traversed by hitScene and
+	// gathers the emitters into the light table, call once after the last add*
+	void finalizeScene(Scene& ro_Scene);
 	Math::HitRecord hitScene(const Scene& ro_Scene, const Math::Ray& ro_Ray);
+	// Closest hit of every active lane, same per-lane result as hitScene on that lane's ray
+	void hitScene(const Scene& ro_Scene, const Math::RayPacket& ro_Packet, Math::PacketHit& ro_Hit);
+	// Visibility query for shadow rays, true as soon as any surface lies in [kEpsilon, v_TMax)
+	bool occludedScene(const Scene& ro_Scene, const Math::Ray& ro_Ray, Math::FP32 v_TMax);
 }
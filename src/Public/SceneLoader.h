@@ -0,0 +1,57 @@
+#pragma once
+#include "Scene.h"
+
+namespace WavefrontPT::Integrator {
+	constexpr uint32_t SCENE_CACHE_MAGIC = 0x4E435357; // "WSCN"
+	constexpr uint32_t SCENE_CACHE_VERSION = 1;
+	// Every array in the cache starts on a cache line
+	constexpr size_t SCENE_CACHE_ALIGNMENT = 64;
+
+	// ----------------------------------------------------------------------------------
+	// Front of <scene>.bin. The arrays follow at their offsets in exactly the in-memory
+	// layout, so a current cache is mapped and used in place. It is current while the
+	// source file keeps its size and modification time and the struct layouts match.
+	// ----------------------------------------------------------------------------------
+	struct SceneCacheHeader final {
+		uint32_t m_Magic;
+		uint32_t m_Version;
+		uint64_t m_SourceBytes;
+		int64_t m_SourceTime;
+
+		uint32_t m_MaterialBytes;
+		uint32_t m_SphereBytes;
+		uint32_t m_PlaneBytes;
+		uint32_t m_MaterialCount;
+		uint32_t m_SphereCount;
+		uint32_t m_PlaneCount;
+		uint64_t m_MaterialOffset;
+		uint64_t m_SphereOffset;
+		uint64_t m_PlaneOffset;
+
+		CameraDesc m_Camera;
+	};
+
+	// Line based, '#' starts a comment, materials are referenced by name and must come first:
+	//   material <name> <r g b> <emission r g b> <metalness> <roughness>
+	//   sphere   <center x y z> <radius> <material>
+	//   plane    <center x y z> <normal x y z> <tangent x y z> <bitangent x y z> <half width> <half breadth> <material>
+	//   camera   <origin x y z> <look-at x y z> <up x y z> <vertical fov degrees>
+	bool parseScene(const char* p_Text, size_t v_Bytes, const char* p_Name, Scene& ro_Scene, std::string& ro_Error);
+
+	// Maps p_Path.bin when it is current for p_Path, otherwise parses p_Path and writes the cache
+	// for the next run. ro_FromCache reports which of the two happened
+	bool loadScene(const char* p_Path, Scene& ro_Scene, bool& ro_FromCache, std::string& ro_Error);
+
+	// Which scene file a render used: hash of the canonical path plus the file's size and
+	// modification time, the same stamp that validates the cache. All zero for the built-in
+	// demo scene (empty path). Returns false if the file cannot be inspected
+	struct SceneIdentity final {
+		uint64_t m_PathHash = 0;
+		uint64_t m_SourceBytes = 0;
+		int64_t m_SourceTime = 0;
+	};
+
+	bool sceneIdentity(const std::string& ro_Path, SceneIdentity& ro_Identity);
+
+	bool writeSceneCache(const char* p_Path, const Scene& ro_Scene, uint64_t v_SourceBytes, int64_t v_SourceTime);
+}
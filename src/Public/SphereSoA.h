@@ -0,0 +1,41 @@
+#pragma once
+#include "GSphere.h"
+#include "IntegratorMathCore.h"
+#include "RayPacket.h"
+
+namespace WavefrontPT::Geometry {
+	constexpr uint32_t SPHERE_BLOCK_WIDTH = 8;
+
+	// ----------------------------------------------------------------------------------
+	// 8 spheres in SoA form so one broadcast ray is tested against all of them with a
+	// single set of __m256 operations. m_Index is the sphere's slot in the scene array.
+	// Unused lanes carry a -inf squared radius, their discriminant is never >= 0.
+	// ----------------------------------------------------------------------------------
+	struct alignas(32) SphereBlock final {
+		Math::FP32 m_CenterX[SPHERE_BLOCK_WIDTH];
+		Math::FP32 m_CenterY[SPHERE_BLOCK_WIDTH];
+		Math::FP32 m_CenterZ[SPHERE_BLOCK_WIDTH];
+		Math::FP32 m_RadiusSq[SPHERE_BLOCK_WIDTH];
+		Integrator::Math::MaterialID m_MaterialID[SPHERE_BLOCK_WIDTH];
+		Integrator::Math::ObjectID m_Index[SPHERE_BLOCK_WIDTH];
+	};
+
+	void clearSphereBlock(SphereBlock& ro_Block);
+	void setSphereLane(SphereBlock& ro_Block, uint32_t v_Lane, const GSphere& ro_Sphere, Integrator::Math::ObjectID v_Index);
+
+	// Nearest lane hit with t in [kEpsilon, v_TMax], same root selection as hit(const Ray&, const GSphere&).
+	// Equal t resolves to the lower sphere index. No HitRecord is built
+	bool intersectSphereBlock(const SphereBlock& ro_Block, const Integrator::Math::Ray& ro_Ray, Math::FP32 v_TMax,
+							  Math::FP32& ro_T, uint32_t& ro_Lane);
+	// Any lane hit with t in [kEpsilon, v_TMax)
+	bool occludedSphereBlock(const SphereBlock& ro_Block, const Integrator::Math::Ray& ro_Ray, Math::FP32 v_TMax);
+
+	// Sphere v_Lane of the block against every ray of the packet. Returns the active lanes that hit with
+	// t in [kEpsilon, v_TMax], ro_T holds their t
+	Math::RegFP32 intersectSpherePacket(const SphereBlock& ro_Block, uint32_t v_Lane, const Integrator::Math::RayPacket& ro_Packet,
+										Math::RegFP32 v_TMax, Math::RegFP32& ro_T);
+
+	// HitRecord for the lane picked by intersectSphereBlock
+	Integrator::Math::HitRecord captureSphereHit(const SphereBlock& ro_Block, uint32_t v_Lane,
+												 const Integrator::Math::Ray& ro_Ray, Math::FP32 v_T);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "Queue.h"
+
+#include <atomic>
+
+namespace WavefrontPT::Threading {
+	constexpr uint32_t TILE_SIZE = 32;
+
+	// Pixel rectangle [m_X0, m_X1) x [m_Y0, m_Y1)
+	struct Tile final {
+		uint32_t m_X0;
+		uint32_t m_Y0;
+		uint32_t m_X1;
+		uint32_t m_Y1;
+
+		uint32_t width() const { return m_X1 - m_X0; }
+		uint32_t height() const { return m_Y1 - m_Y0; }
+		uint32_t pixelCount() const { return width() * height(); }
+	};
+
+	inline uint32_t tileCount(uint32_t v_Width, uint32_t v_Height, uint32_t v_TileSize = TILE_SIZE) {
+		return ((v_Width + v_TileSize - 1) / v_TileSize) * ((v_Height + v_TileSize - 1) / v_TileSize);
+	}
+
+	// ----------------------------------------------------------------------------------
+	// Cuts the image into square tiles and deals every worker a contiguous run of them.
+	// A worker drains its own deque first and then steals from the others, so workers
+	// that drew cheap sky tiles end up helping with the expensive ones.
+	// Tiles are dealt in the constructor, before the workers start, and never re-queued.
+	// ----------------------------------------------------------------------------------
+	class TileScheduler final {
+		using TileQueue = ChaseLevQueue<uint32_t>;
+
+		std::vector<std::unique_ptr<TileQueue>> m_Queues;
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_TileSize;
+		uint32_t m_TilesX;
+		uint32_t m_TileCount;
+
+		alignas(64) std::atomic<uint32_t> m_Remaining;
+		std::atomic<uint32_t> m_Steals;
+
+		Tile tileAt(uint32_t v_Index) const;
+
+	public:
+		TileScheduler(uint32_t v_Width, uint32_t v_Height, uint32_t v_WorkerCount, uint32_t v_TileSize = TILE_SIZE);
+
+		TileScheduler(const TileScheduler&) = delete;
+		TileScheduler& operator=(const TileScheduler&) = delete;
+		TileScheduler(TileScheduler&&) = delete;
+		TileScheduler& operator=(TileScheduler&&) = delete;
+		~TileScheduler() = default;
+
+		// Claims the next tile for v_Worker, false once every tile has been handed out
+		bool next(uint32_t v_Worker, Tile& ro_Tile);
+
+		uint32_t tileCount() const { return m_TileCount; }
+		uint32_t stealCount() const { return m_Steals.load(std::memory_order_relaxed); }
+	};
+}
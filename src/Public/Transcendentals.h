@@ -1,4 +1,5 @@
 #pragma once
+#include <Functions.h>
 
 namespace WavefrontPT::Math::Transcendentals {
 
@@ -48,4 +49,41 @@ namespace WavefrontPT::Math::Transcendentals {
         return sincos(v_Rad).second;
     }
 
+    // Single precision Cody-Waite split of pi/2, each part exact in float
+    constexpr float PI_2_HI_F = 1.5703125f;
+    constexpr float PI_2_MID_F = 4.837512969970703125e-4f;
+    constexpr float PI_2_LO_F = 7.54978995489188216e-8f;
+    constexpr float INV_PI_2_F = 0.636619772367581343f;
+
+    // Float minimax polynomials on [-pi/4, pi/4]
+    constexpr float SIN_F3 = -1.6666654611e-1f;
+    constexpr float SIN_F5 = 8.3321608736e-3f;
+    constexpr float SIN_F7 = -1.9515295891e-4f;
+    constexpr float COS_F4 = 4.166664568298827e-2f;
+    constexpr float COS_F6 = -1.388731625493765e-3f;
+    constexpr float COS_F8 = 2.443315711809948e-5f;
+
+    // 8 lanes in single precision with float range reduction, meant for the [0, 2pi) sampling
+    // angles. measureSincosError reports its error against double precision
+    void sincos(const Reg8& r_Rad, Reg8& ro_Sin, Reg8& ro_Cos);
+
+    struct SincosErrorBound final {
+        double m_MaxSin = 0.0;
+        double m_MaxCos = 0.0;
+        float m_WorstAngle = 0.0f;
+
+        // Worst absolute error in ulps of values in [0.5, 1), 2^-24
+        double maxUlps() const { return std::max(m_MaxSin, m_MaxCos) * 16777216.0; }
+    };
+
+    struct SincosError final {
+        SincosErrorBound m_Vector;
+        SincosErrorBound m_Scalar;
+        uint64_t m_Samples = 0;
+    };
+
+    // Accuracy harness: evaluates the Reg8 sincos and the scalar sincos(float) at v_Samples evenly
+    // spaced angles in [v_Begin, v_End) and reports their absolute errors against double precision
+    SincosError measureSincosError(float v_Begin, float v_End, uint64_t v_Samples);
+
 }
@@ -60,6 +60,11 @@ namespace WavefrontPT::Math {
 		return Transcendentals::cos(v);
 	}
 
+	// Both from one evaluation, for callers that need the pair
+	inline std::pair<FP32, FP32> sinCosFP(FP32 v) {
+		return Transcendentals::sincos(v);
+	}
+
 	inline constexpr Vector3 operator-(const Point3& ro_A, const Point3& ro_B) noexcept {
 		return { ro_A.X - ro_B.X, ro_A.Y - ro_B.Y, ro_A.Z - ro_B.Z };
 	}
@@ -94,8 +99,8 @@ namespace WavefrontPT::Math {
 
 	inline constexpr Vector3 cross(const Vector3& ro_OpA, const Vector3& ro_OpB) noexcept {
 		return { ro_OpA.Y * ro_OpB.Z - ro_OpA.Z * ro_OpB.Y,
-			ro_OpA.Z * ro_OpB.X - ro_OpB.X * ro_OpA.Z,
-			ro_OpA.X * ro_OpB.Y - ro_OpB.X * ro_OpA.Y };
+			ro_OpA.Z * ro_OpB.X - ro_OpA.X * ro_OpB.Z,
+			ro_OpA.X * ro_OpB.Y - ro_OpA.Y * ro_OpB.X };
 	}
 
 	inline constexpr Vector3 scale(const Vector3& ro_Vec, FP32 v_Scalar) noexcept {
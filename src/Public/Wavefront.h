@@ -0,0 +1,151 @@
+#pragma once
+#include "Accumulation.h"
+#include "Camera.h"
+#include "FrameArena.h"
+#include "IntegratorMathCore.h"
+#include "Payload.h"
+#include "Scene.h"
+#include "TileScheduler.h"
+
+namespace WavefrontPT::Integrator {
+	// Indices into WavefrontBatch::m_Paths
+	using RayQueue = Memory::FrameArray<uint32_t>;
+
+	// Upper bound on in-flight paths per worker
+	constexpr size_t WAVEFRONT_BATCH_SIZE = 1 << 16;
+
+	// Camera rays are generated and traced as one packet per 4x2 pixel block and sample
+	constexpr uint32_t CAMERA_BLOCK_WIDTH = 4;
+	constexpr uint32_t CAMERA_BLOCK_HEIGHT = 2;
+	static_assert(CAMERA_BLOCK_WIDTH * CAMERA_BLOCK_HEIGHT == Math::RAY_PACKET_WIDTH);
+
+	inline uint32_t cameraBlockCount(const Threading::Tile& ro_Tile) {
+		return ((ro_Tile.width() + CAMERA_BLOCK_WIDTH - 1) / CAMERA_BLOCK_WIDTH)
+			* ((ro_Tile.height() + CAMERA_BLOCK_HEIGHT - 1) / CAMERA_BLOCK_HEIGHT);
+	}
+
+	// Shading buckets, misses first and then one per Materials::MaterialClass
+	constexpr uint32_t SHADE_BUCKET_MISS = 0;
+	constexpr uint32_t SHADE_BUCKET_COUNT = 1 + Materials::MATERIAL_CLASS_COUNT;
+
+	inline uint32_t shadeBucket(Materials::MaterialClass v_Class) {
+		return 1 + static_cast<uint32_t>(v_Class);
+	}
+
+	// Camera jitter takes the first dimensions of every (pixel, sample) sequence
+	constexpr uint32_t CAMERA_JITTER_DIMENSIONS = 2;
+
+	// Sampler of the path through (pixel, sample), continuing after the camera jitter.
+	// Shared by both integrators so they trace identical paths
+	inline Integrators::Ops::PathSampler pathSampler(Integrators::Ops::SamplerType v_Type, size_t v_Pixel, int v_Sample) {
+		return Integrators::Ops::makePathSampler(v_Type, uint32_t(v_Pixel), uint32_t(v_Sample), CAMERA_JITTER_DIMENSIONS);
+	}
+
+	// Jitters, generates and traces sample v_Sample of the tile's block v_Block as one packet.
+	// Lanes past the tile edge or on converged pixels are inactive. Returns the active lane mask,
+	// p_Pixels receives the image index of every active lane
+	uint32_t traceCameraPacket(const Scene& ro_Scene, const Camera& ro_Camera, const PixelStats* p_Stats,
+							   size_t v_Width, size_t v_Height, const Threading::Tile& ro_Tile, uint32_t v_Block, int v_Sample,
+							   Integrators::Ops::SamplerType v_Sampler, uint32_t* p_Pixels,
+							   Math::RayPacket& ro_Packet, Math::PacketHit& ro_Hit);
+
+	// ----------------------------------------------------------------------------------
+	// Per-worker wavefront state. Paths stay resident in m_Paths while the stage
+	// passes move their indices between queues, so every pass runs one kernel over
+	// the whole batch instead of one path through every kernel.
+	// Storage is carved from the worker's FrameArena and dies with its next reset.
+	// ----------------------------------------------------------------------------------
+	struct WavefrontBatch final {
+		Memory::FrameArray<Payload> m_Paths;
+		Memory::FrameArray<uint32_t> m_PixelIndex;
+		Memory::FrameArray<Math::HitRecord> m_Hits;
+		RayQueue m_Active;
+		RayQueue m_Next;
+		Memory::FrameArray<ShadowRay> m_ShadowQueue;
+		// m_Active split by shadeBucket, refilled by every shadeHits
+		RayQueue m_Buckets[SHADE_BUCKET_COUNT];
+		// Radix sort ping-pong buffers, sort key in the high half and path index in the low half
+		Memory::FrameArray<uint64_t> m_SortKeys;
+		Memory::FrameArray<uint64_t> m_SortScratch;
+
+		WavefrontBatch() = default;
+
+		WavefrontBatch(const WavefrontBatch&) = delete;
+		WavefrontBatch& operator=(const WavefrontBatch&) = delete;
+		WavefrontBatch(WavefrontBatch&&) noexcept = default;
+		WavefrontBatch& operator=(WavefrontBatch&&) noexcept = default;
+		~WavefrontBatch() = default;
+
+		// Room for v_Capacity in-flight paths, false if the arena is exhausted
+		bool allocate(Memory::FrameArena& ro_Arena, uint32_t v_Capacity) {
+			return m_Paths.allocate(ro_Arena, v_Capacity)
+				&& m_PixelIndex.allocate(ro_Arena, v_Capacity)
+				&& m_Hits.allocate(ro_Arena, v_Capacity)
+				&& m_Active.allocate(ro_Arena, v_Capacity)
+				&& m_Next.allocate(ro_Arena, v_Capacity)
+				&& m_ShadowQueue.allocate(ro_Arena, v_Capacity)
+				&& m_SortKeys.allocate(ro_Arena, v_Capacity)
+				&& m_SortScratch.allocate(ro_Arena, v_Capacity)
+				&& allocateBuckets(ro_Arena, v_Capacity);
+		}
+
+		bool allocateBuckets(Memory::FrameArena& ro_Arena, uint32_t v_Capacity) {
+			for (RayQueue& bucket : m_Buckets)
+				if (!bucket.allocate(ro_Arena, v_Capacity)) return false;
+			return true;
+		}
+	};
+
+	// Origin cells per axis of the ray sort key, as a power of two
+	constexpr uint32_t RAY_SORT_CELL_BITS = 9;
+	// Radix sort digit width, one 256-entry histogram per pass
+	constexpr uint32_t RAY_SORT_DIGIT_BITS = 8;
+
+	// Direction octant in the top 3 bits, then the Morton code of the origin's cell in a
+	// 2^RAY_SORT_CELL_BITS grid over ro_Bounds. Origins outside the bounds clamp to the edge cells
+	uint32_t raySortKey(const Math::Ray& ro_Ray, const Geometry::AABB& ro_Bounds);
+
+	// One path per (pixel, sample) for the tile's camera blocks [v_BlockBegin, v_BlockEnd) and
+	// samples [v_SampleBegin, v_SampleEnd), fills m_Active. Camera rays are traced here as packets,
+	// so m_Hits already holds the first hits. Pixels already marked converged in p_Stats get no paths
+	void generateCameraRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene, const Camera& ro_Camera, const PixelStats* p_Stats,
+							size_t v_Width, size_t v_Height, const Threading::Tile& ro_Tile,
+							uint32_t v_BlockBegin, uint32_t v_BlockEnd, int v_SampleBegin, int v_SampleEnd,
+							Integrators::Ops::SamplerType v_Sampler);
+
+	// Reorders m_Active by raySortKey with an LSD radix sort, so rays leaving the same region
+	// in the same direction octant are traced back to back and share BVH nodes in cache
+	void sortRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene);
+
+	// Closest hit for every path in m_Active, from the second bounce on
+	void extendRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene);
+
+	// Consumes m_Active, emits surviving paths into m_Next and NEE samples into m_ShadowQueue.
+	// Hits are first split into m_Buckets by material class, then each bucket runs the
+	// kernel specialized for its class, so no kernel branches on the material per hit.
+	// v_Roulette plays Russian roulette on the surviving paths before they enter m_Next
+	void shadeHits(WavefrontBatch& ro_Batch, const Scene& ro_Scene, bool v_Roulette);
+
+	// Traces m_ShadowQueue and deposits visible contributions into their paths
+	void connectShadowRays(WavefrontBatch& ro_Batch, const Scene& ro_Scene);
+
+	// Adds samples [v_SampleBegin, v_SampleEnd) of the tile's unconverged pixels into
+	// ro_Accumulation, then re-tests their convergence. Resets ro_Arena and allocates
+	// the tile's batch from it, at most WAVEFRONT_BATCH_SIZE paths whatever the sample count.
+	// v_SortRays runs sortRays before every extension pass
+	void renderWavefrontTile(
+		Memory::FrameArena& ro_Arena,
+		const Scene& ro_Scene,
+		AccumulationBuffer& ro_Accumulation,
+		const Threading::Tile& ro_Tile,
+		size_t v_Width,
+		size_t v_Height,
+		int v_SampleBegin,
+		int v_SampleEnd,
+		int v_MaxBounces,
+		int v_RouletteDepth,
+		Math::FP32 v_AdaptiveThreshold,
+		Integrators::Ops::SamplerType v_Sampler,
+		bool v_SortRays,
+		const Camera& ro_Camera);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "BVH.h"
+#include "IntegratorMathCore.h"
+#include "MemoryAllocators.h"
+#include "SphereSoA.h"
+
+namespace WavefrontPT::Geometry {
+	constexpr uint32_t BVH8_WIDTH = 8;
+	constexpr uint32_t BVH8_EMPTY_SLOT = UINT32_MAX;
+
+	// ----------------------------------------------------------------------------------
+	// 8 child boxes in SoA form so one ray tests every child with a single set of
+	// __m256 slab tests. Slot i is
+	//   interior: m_Child[i] = wide node index, m_Count[i] == 0
+	//   leaf:     m_Child[i] = index into BVH8::m_Leaves, m_Count[i] = primitive count > 0
+	//   empty:    m_Child[i] = BVH8_EMPTY_SLOT, inverted box so it never hits
+	// ----------------------------------------------------------------------------------
+	struct alignas(32) BVH8Node final {
+		Math::FP32 m_MinX[BVH8_WIDTH];
+		Math::FP32 m_MinY[BVH8_WIDTH];
+		Math::FP32 m_MinZ[BVH8_WIDTH];
+		Math::FP32 m_MaxX[BVH8_WIDTH];
+		Math::FP32 m_MaxY[BVH8_WIDTH];
+		Math::FP32 m_MaxZ[BVH8_WIDTH];
+		uint32_t m_Child[BVH8_WIDTH];
+		uint32_t m_Count[BVH8_WIDTH];
+	};
+
+	// Leaf payload: its spheres as whole SoA blocks, its planes as refs into BVH8::m_Primitives
+	struct BVH8Leaf final {
+		uint32_t m_SphereBlock;
+		uint32_t m_SphereBlockCount;
+		uint32_t m_PlaneOffset;
+		uint32_t m_PlaneCount;
+	};
+
+	struct BVH8Stats final {
+		uint32_t m_NodeCount = 0;
+		Math::FP32 m_AverageFill = 0.0f;
+		uint32_t m_SphereBlockCount = 0;
+		// Occupied lanes over all sphere block lanes
+		Math::FP32 m_SphereLaneFill = 0.0f;
+		double m_CollapseMs = 0.0;
+	};
+
+	struct BVH8 final {
+		Memory::ArenaWalker<BVH8Node> m_NodeArena;
+		BVH8Node* m_Nodes = nullptr;
+		uint32_t m_NodeCount = 0;
+		// Every sphere lands in exactly one block, so the blocks are a leaf-ordered SoA copy of the sphere array
+		Memory::ArenaWalker<SphereBlock> m_SphereBlockArena;
+		SphereBlock* m_SphereBlocks = nullptr;
+		uint32_t m_SphereBlockCount = 0;
+		std::vector<BVH8Leaf> m_Leaves;
+		// Plane refs only, spheres are reached through the blocks
+		std::vector<PrimitiveRef> m_Primitives;
+		AABB m_RootBounds;
+		BVH8Stats m_Stats;
+
+		BVH8() = default;
+
+		BVH8(const BVH8&) = delete;
+		BVH8& operator=(const BVH8&) = delete;
+		BVH8(BVH8&&) noexcept = default;
+		BVH8& operator=(BVH8&&) noexcept = default;
+		~BVH8() = default;
+
+		bool isEmpty() const { return m_NodeCount == 0; }
+	};
+
+	// Collapses a binary BVH by repeatedly opening the largest-area interior child until 8 slots fill,
+	// then packs every leaf's spheres into SoA blocks
+	BVH8 collapseBVH(const BVH& ro_Binary, const GSphere* p_Spheres);
+
+	// Same contract as intersect(const BVH&, ...), children are visited nearest first
+	[[nodiscard]] Integrator::Math::HitRecord intersect(const BVH8& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes,
+														const Integrator::Math::Ray& ro_Ray);
+
+	// Packet form for coherent rays: each node's boxes are tested against every live ray of the
+	// packet at once and a subtree is skipped only when no live ray enters it. Per-lane results
+	// follow the single-ray contract, including the tie-break on equal t
+	void intersect(const BVH8& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes,
+				   const Integrator::Math::RayPacket& ro_Packet, Integrator::Math::PacketHit& ro_Hit);
+
+	// Any-hit counterpart of intersect(const BVH8&, ...) for shadow rays
+	[[nodiscard]] bool occluded(const BVH8& ro_BVH, const GSphere* p_Spheres, const GPlane* p_Planes,
+								const Integrator::Math::Ray& ro_Ray, Math::FP32 v_TMax);
+}